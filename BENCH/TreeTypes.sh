@@ -0,0 +1,66 @@
+#!/bin/sh
+#
+# Compares the tour representations TWO-LEVEL, THREE-LEVEL and BALANCED
+# (see TREE_TYPE in the README).
+#
+# Usage: sh BENCH/TreeTypes.sh [ problem ... ]
+#
+# The script is run from the top directory after make, or with LKH set to
+# the path of the program. A problem is pr2392 (100 trials on pr2392.tsp)
+# or the size n of a random instance (1 trial on n points drawn uniformly
+# from [0,10^7)^2, EUC_2D). The default problems are pr2392, 100000 and
+# 1000000. The random instances are generated once (with a fixed seed) in
+# BENCH/WORK, where the parameter files are written too.
+#
+# Each run uses a greedy initial tour, 5 quadrant candidates, no
+# subgradient ascent and 5-opt moves. The time of run 1, which excludes
+# the preprocessing, is reported. Run the script on an otherwise idle
+# machine; LKH uses a single core.
+
+LKH=${LKH:-`pwd`/LKH}
+WORK=BENCH/WORK
+PROBLEMS=${*:-"pr2392 100000 1000000"}
+
+mkdir -p $WORK
+for P in $PROBLEMS; do
+    if [ $P = pr2392 ]; then
+        FILE=`pwd`/pr2392.tsp
+        TRIALS=100
+    else
+        FILE=r$P.tsp
+        TRIALS=1
+        if [ ! -f $WORK/$FILE ]; then
+            awk -v n=$P 'BEGIN {
+                srand(1);
+                print "NAME : r" n;
+                print "TYPE : TSP";
+                print "DIMENSION : " n;
+                print "EDGE_WEIGHT_TYPE : EUC_2D";
+                print "NODE_COORD_SECTION";
+                for (i = 1; i <= n; i++)
+                    printf "%d %d %d\n", i, int(rand() * 10000000),
+                                            int(rand() * 10000000);
+                print "EOF";
+            }' > $WORK/$FILE
+        fi
+    fi
+    for TREE_TYPE in TWO-LEVEL THREE-LEVEL BALANCED; do
+        PAR=$P.$TREE_TYPE.par
+        cat > $WORK/$PAR <<EOP
+PROBLEM_FILE = $FILE
+RUNS = 1
+MAX_TRIALS = $TRIALS
+MOVE_TYPE = 5
+CANDIDATE_SET_TYPE = QUADRANT
+MAX_CANDIDATES = 5
+INITIAL_PERIOD = 1
+SUBGRADIENT = NO
+INITIAL_TOUR_ALGORITHM = GREEDY
+TREE_TYPE = $TREE_TYPE
+SEED = 1
+TRACE_LEVEL = 1
+EOP
+        printf "%-8s %-12s " $P $TREE_TYPE
+        (cd $WORK && $LKH $PAR) | grep "^Run 1:"
+    done
+done
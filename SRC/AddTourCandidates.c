@@ -26,7 +26,7 @@ void AddTourCandidates()
     for (i = 0; i < MergeTourFiles; i++) {
         Na = FirstNode;
         do {
-            Nb = Na->MergeSuc[i];
+            Nb = MergeSuc(Na, i);
             if (!Nb)
                 break;
             if (Na->Subproblem == Subproblem &&
@@ -42,7 +42,7 @@ void AddTourCandidates()
     // 把INITIAL_TOUR_FILE这个文件中的边添加进来，这个do while循环内部的第二个if语句永远不会进入。其实什么都没有做
     Na = FirstNode;
     do {
-        Nb = Na->InitialSuc;
+        Nb = InitialSucTable ? InitialSuc(Na) : 0;
         if (!Nb)
             break;
         if (Na->Subproblem == Subproblem && Nb->Subproblem == Subproblem) {
@@ -56,7 +56,7 @@ void AddTourCandidates()
     /* Add INPUT_TOUR_FILE edges */
     Na = FirstNode;
     do {
-        Nb = Na->InputSuc;
+        Nb = InputSucTable ? InputSuc(Na) : 0;
         if (!Nb)
             break;
         if (Na->Subproblem == Subproblem && Nb->Subproblem == Subproblem) {
@@ -70,7 +70,7 @@ void AddTourCandidates()
     /* Add SUBPROBLEM_TOUR_FILE edges */
     Na = FirstNode;
     do {
-        Nb = Na->SubproblemSuc;
+        Nb = SubproblemLinkTable ? SubproblemSuc(Na) : 0;
         if (!Nb)
             break;
         if (Na->Subproblem == Subproblem && Nb->Subproblem == Subproblem) {
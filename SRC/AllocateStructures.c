@@ -1,4 +1,3 @@
-#include "Segment.h"
 #include "LKH.h"
 #include "Heap.h"
 #include "Sequence.h"
@@ -10,18 +9,18 @@
 // AllocateStructures()函数会分配所有除了节点和候选集以外的内存结构
 
 #define Free(s) { free(s); s = 0; }
+#define FreeLarge(s) { LargeFree(s); s = 0; }
 
 void AllocateStructures()
 {
     int i, K;
 
     Free(Heap);
-    Free(BestTour);
-    Free(BetterTour);
+    FreeLarge(BestTour);
+    FreeLarge(BetterTour);
     Free(HTable);
-    Free(Rand);
-    Free(CacheSig);
-    Free(CacheVal);
+    FreeLarge(Rand);
+    FreeLarge(DistanceCache);
     Free(T);
     Free(G);
     Free(t);
@@ -31,22 +30,24 @@ void AllocateStructures()
     Free(tSaved);
 
     MakeHeap(Dimension);
-    assert(BestTour = (int *) calloc(1 + Dimension, sizeof(int)));
-    assert(BetterTour = (int *) calloc(1 + Dimension, sizeof(int)));
+    BestTour = (int *) LargeCalloc(1 + Dimension, sizeof(int));
+    BetterTour = (int *) LargeCalloc(1 + Dimension, sizeof(int));
     assert(HTable = (HashTable *) malloc(sizeof(HashTable)));
     HashInitialize((HashTable *) HTable);
     SRandom(Seed);
-    assert(Rand = (unsigned *)
-           malloc((Dimension + 1) * sizeof(unsigned)));
+    Rand = (unsigned *) LargeCalloc(Dimension + 1, sizeof(unsigned));
     for (i = 1; i <= Dimension; i++)
         Rand[i] = Random();
     SRandom(Seed);
     if (WeightType != EXPLICIT) {
-        for (i = 0; (1 << i) < (Dimension << 1); i++);
-        i = 1 << i;
-        assert(CacheSig = (int *) calloc(i, sizeof(int)));
-        assert(CacheVal = (int *) calloc(i, sizeof(int)));
-        CacheMask = i - 1;
+        /* The number of sets is the smallest power of 2 that makes room 
+           for the requested number of entries (default: 2 * Dimension) */
+        K = DistanceCacheSize >= 0 ? DistanceCacheSize : 2 * Dimension;
+        if (K > 0) {
+            for (i = 1; i * CACHE_WAYS < K; i <<= 1);
+            DistanceCache = (CacheSet *) LargeCalloc(i, sizeof(CacheSet));
+            CacheMask = i - 1;
+        }
     }
     AllocateSegments();
     K = MoveType;
@@ -65,26 +66,53 @@ void AllocateStructures()
 }
 
 /*      
- * The AllocateSegments function allocates the segments of the two-level tree.
+ * The AllocateSegments function chooses the tour representation and
+ * allocates the segments of the two-level (or three-level) tree, the
+ * array of the array representation, or the tree nodes of the balanced
+ * tree representation.
  */
 
 void AllocateSegments()
+{
+    FreeSegments();
+    ChooseTreeType();
+    if (CurrentTreeType == ARRAY_TOUR)
+        assert(TourArray =
+               (Node **) malloc((1 + Dimension) * sizeof(Node *)));
+    else if (CurrentTreeType == BALANCED_TREE_TOUR)
+        assert(BTree =
+               (BTNode *) calloc(1 + DimensionSaved, sizeof(BTNode)));
+    GroupSize =
+        CurrentTreeType == THREE_LEVEL_LIST ?
+        (int) pow((double) Dimension, 1.0 / 3.0) :
+        CurrentTreeType == TWO_LEVEL_LIST ?
+        (int) sqrt((double) Dimension) : Dimension;
+    SGroupSize = CurrentTreeType == THREE_LEVEL_LIST ?
+        sqrt((double) ((Dimension + GroupSize - 1) / GroupSize)) :
+        Dimension;
+    PartitionSegments();
+    StartFlipSampling();
+}
+
+/*      
+ * The PartitionSegments function (re)allocates the segments and super
+ * segments according to the current values of GroupSize and SGroupSize.
+ * The nodes are assigned to the segments by the LinKernighan function.
+ *
+ * The segments are allocated from SegmentArena, so that they are stored
+ * contiguously and may be freed in one step.
+ */
+
+void PartitionSegments()
 {
     Segment *S = 0, *SPrev;
     SSegment *SS = 0, *SSPrev;
     int i;
 
-    FreeSegments();
-#ifdef THREE_LEVEL_TREE
-    GroupSize = (int) pow((double) Dimension, 1.0 / 3.0);
-#elif defined TWO_LEVEL_TREE
-    GroupSize = (int) sqrt((double) Dimension);
-#else
-    GroupSize = Dimension;
-#endif
+    FreeSegmentLists();
     Groups = 0;
     for (i = Dimension, SPrev = 0; i > 0; i -= GroupSize, SPrev = S) {
-        assert(S = (Segment *) malloc(sizeof(Segment)));
+        S = (Segment *) ArenaAlloc(&SegmentArena, sizeof(Segment));
         S->Rank = ++Groups;
         if (!SPrev)
             FirstSegment = S;
@@ -92,14 +120,9 @@ void AllocateSegments()
             SLink(SPrev, S);
     }
     SLink(S, FirstSegment);
-#ifdef THREE_LEVEL_TREE
-    SGroupSize = sqrt((double) Groups);
-#else
-    SGroupSize = Dimension;
-#endif
     SGroups = 0;
     for (i = Groups, SSPrev = 0; i > 0; i -= SGroupSize, SSPrev = SS) {
-        SS = (SSegment *) malloc(sizeof(SSegment));
+        SS = (SSegment *) ArenaAlloc(&SegmentArena, sizeof(SSegment));
         SS->Rank = ++SGroups;
         if (!SSPrev)
             FirstSSegment = SS;
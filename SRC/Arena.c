@@ -0,0 +1,131 @@
+#include "LKH.h"
+
+/*
+ * The functions in this file implement arenas (regions) of memory.
+ *
+ * Space is allocated from an arena by ArenaAlloc (or ArenaCalloc), which
+ * advances a pointer in the current block of the arena. Space is never
+ * freed individually. Instead, MarkArena records the current state of an
+ * arena, and ReleaseArena returns all space allocated after a mark in one
+ * step. ResetArena returns all space of an arena, and FreeArena returns
+ * the blocks of an arena to the system.
+ *
+ * Blocks that are no longer used are kept in a list of spare blocks and
+ * reused by later allocations. In this way, the same memory is used again
+ * and again when space for a subproblem is repeatedly allocated and
+ * released, and the heap is not fragmented.
+ *
+ * Each block consists of a header followed by at least ARENA_BLOCK_SIZE
+ * bytes. All allocated space is aligned to ARENA_ALIGN bytes.
+ */
+
+#define ARENA_BLOCK_SIZE (1 << 20)
+#define ARENA_ALIGN 16
+
+struct ArenaBlock {
+    ArenaBlock *Prev;           /* The previously allocated block */
+    size_t Size;                /* Number of bytes following the header */
+};
+
+#define HEADER ((sizeof(ArenaBlock) + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1))
+
+/*
+ * The ArenaAlloc function allocates Size bytes from arena A.
+ */
+
+void *ArenaAlloc(Arena * A, size_t Size)
+{
+    ArenaBlock *B, **Spare;
+    char *P;
+
+    Size = (Size + ARENA_ALIGN - 1) & ~(size_t) (ARENA_ALIGN - 1);
+    if (!A->Block || A->Used + Size > A->Block->Size) {
+        for (Spare = &A->Spare; (B = *Spare) && B->Size < Size;
+             Spare = &B->Prev);
+        if (B)
+            *Spare = B->Prev;
+        else {
+            size_t BlockSize = Size > ARENA_BLOCK_SIZE ?
+                Size : ARENA_BLOCK_SIZE;
+            assert(B = (ArenaBlock *) malloc(HEADER + BlockSize));
+            B->Size = BlockSize;
+        }
+        B->Prev = A->Block;
+        A->Block = B;
+        A->Used = 0;
+    }
+    P = (char *) A->Block + HEADER + A->Used;
+    A->Used += Size;
+    return P;
+}
+
+/*
+ * The ArenaCalloc function allocates space for Count elements of Size
+ * bytes from arena A. The space is initialized to zero.
+ */
+
+void *ArenaCalloc(Arena * A, size_t Count, size_t Size)
+{
+    void *P = ArenaAlloc(A, Count * Size);
+    memset(P, 0, Count * Size);
+    return P;
+}
+
+/*
+ * The MarkArena function returns the current state of arena A.
+ */
+
+ArenaMark MarkArena(Arena * A)
+{
+    ArenaMark M;
+
+    M.Block = A->Block;
+    M.Used = A->Used;
+    return M;
+}
+
+/*
+ * The ReleaseArena function releases all space allocated from arena A
+ * after the mark M was made. The blocks allocated after the mark become
+ * spare blocks.
+ */
+
+void ReleaseArena(Arena * A, ArenaMark M)
+{
+    ArenaBlock *B;
+
+    while ((B = A->Block) != M.Block) {
+        A->Block = B->Prev;
+        B->Prev = A->Spare;
+        A->Spare = B;
+    }
+    A->Used = M.Used;
+}
+
+/*
+ * The ResetArena function releases all space allocated from arena A.
+ */
+
+void ResetArena(Arena * A)
+{
+    ArenaMark M;
+
+    M.Block = 0;
+    M.Used = 0;
+    ReleaseArena(A, M);
+}
+
+/*
+ * The FreeArena function returns all blocks of arena A to the system.
+ */
+
+void FreeArena(Arena * A)
+{
+    ArenaBlock *B;
+
+    ResetArena(A);
+    while ((B = A->Spare)) {
+        A->Spare = B->Prev;
+        free(B);
+    }
+}
@@ -0,0 +1,139 @@
+#include "LKH.h"
+
+/*
+ * This file contains the functions that are used for maintaining the
+ * balanced tree representation of a tour.
+ *
+ * In this representation the tour is kept in a treap (a randomized binary
+ * search tree), in which the symmetric order of the nodes is the sequence
+ * of the tour. The tree node of a tour node t is BTree[t->Id]. The priority
+ * of a tree node is the random value, Rand[t->Id], that is used for hashing
+ * tours, so the expected depth of the tree is O(log n).
+ *
+ * Each tree node has a reversal bit, Reversed, which signifies that the 
+ * sequence represented by its subtree is to be traversed in backward 
+ * direction. The bits are propagated lazily to the children (by the
+ * Flip_BT function). As in the two-level tree representation, Pred and 
+ * Suc of each tour node reference its two neighbors, but their meaning 
+ * depends on the orientation of the node: if the exclusive or of the 
+ * Flipped bit of the node and the Reversed bits of the node and all its
+ * ancestors is 1, Pred and Suc are interchanged.
+ *
+ * Finding the orientation of a node (Flipped_BT) and its position in the
+ * sequence (Position_BT) takes time proportional to its depth in the tree.
+ * Since the local search asks for the same nodes many times between two 
+ * consecutive 2-opt moves, the results are cached in the tree nodes.
+ * A 2-opt move (Flip_BT) is made by splitting the tree into three parts,
+ * switching the reversal bit of the middle part, and merging the parts;
+ * its expected time cost is O(log n).
+ */
+
+static void Locate(int u);
+static int SetSize(int t);
+
+/*
+ * The BuildBTree function builds the tree from the current tour, starting
+ * at FirstNode and following the Suc pointers. The tree is built in linear
+ * time by inserting the nodes one by one along the right spine of the tree.
+ *
+ * The function is called from the LinKernighan function.
+ */
+
+void BuildBTree()
+{
+    Node *N = FirstNode;
+    BTNode *T;
+    int t, u, v;
+
+    v = 0;
+    do {
+        T = &BTree[t = N->Id];
+        T->Left = T->Right = 0;
+        T->Reversed = T->Flipped = 0;
+        T->Stamp = 0;
+        for (u = 0; v && Rand[v] < Rand[t]; v = BTree[v].Parent)
+            u = v;
+        if ((T->Left = u))
+            BTree[u].Parent = t;
+        if ((T->Parent = v))
+            BTree[v].Right = t;
+        v = t;
+    }
+    while ((N = N->Suc) != FirstNode);
+    while (BTree[v].Parent)
+        v = BTree[v].Parent;
+    SetSize(BTreeRoot = v);
+    BTreeStamp = 1;
+}
+
+/*
+ * The Flipped_BT function returns 1 if Pred and Suc of node t are 
+ * interchanged; otherwise 0.
+ */
+
+int Flipped_BT(const Node * t)
+{
+    BTNode *T = &BTree[t->Id];
+
+    if (T->Stamp != BTreeStamp)
+        Locate(t->Id);
+    return T->Orientation;
+}
+
+/*
+ * The Position_BT function returns the position of node t in the 
+ * sequence represented by the tree (0, 1, ..., Dimension - 1).
+ */
+
+int Position_BT(const Node * t)
+{
+    BTNode *T = &BTree[t->Id];
+
+    if (T->Stamp != BTreeStamp)
+        Locate(t->Id);
+    return T->Position;
+}
+
+/*
+ * The Locate function determines the orientation and position of tree 
+ * node u by walking from u to the root. The results are cached in u until
+ * the tree is changed (BTreeStamp is incremented by each change).
+ */
+
+static void Locate(int u)
+{
+    BTNode *T = &BTree[u], *U = T;
+    int v, Before, After, Temp, Orientation = T->Flipped;
+
+    /* Before and After are the numbers of nodes in the current subtree
+       that precede and follow u in the sequence represented by the 
+       subtree */
+    Before = BTree[T->Left].Size;
+    After = BTree[T->Right].Size;
+    for (;;) {
+        if (T->Reversed) {
+            Temp = Before;
+            Before = After;
+            After = Temp;
+            Orientation ^= 1;
+        }
+        if (!(v = T->Parent))
+            break;
+        T = &BTree[v];
+        if (u == T->Left)
+            After += BTree[T->Right].Size + 1;
+        else
+            Before += BTree[T->Left].Size + 1;
+        u = v;
+    }
+    U->Position = Before;
+    U->Orientation = Orientation;
+    U->Stamp = BTreeStamp;
+}
+
+static int SetSize(int t)
+{
+    return !t ? 0 :
+        (BTree[t].Size =
+         SetSize(BTree[t].Left) + SetSize(BTree[t].Right) + 1);
+}
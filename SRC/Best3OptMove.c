@@ -67,7 +67,7 @@ Node *Best3OptMove(Node * t1, Node * t2, GainType * G0, GainType * Gain)
             t4 = X4 == 1 ? PRED(t3) : SUC(t3);
             if (FixedOrCommon(t3, t4))
                 continue;
-            G2 = G1 + C(t3, t4);
+            G2 = G1 + TOUR_COST(t3, t4);
             if (X4 == 1 &&
                 !Forbidden(t4, t1) &&
                 (!c || G2 - c(t4, t1) > 0) && (*Gain = G2 - C(t4, t1)) > 0)
@@ -100,7 +100,7 @@ Node *Best3OptMove(Node * t1, Node * t2, GainType * G0, GainType * Gain)
                     }
                     if (FixedOrCommon(t5, t6))
                         continue;
-                    G4 = G3 + C(t5, t6);
+                    G4 = G3 + TOUR_COST(t5, t6);
                     if (!Forbidden(t6, t1) &&
                         (!c || G4 - c(t6, t1) > 0) &&
                         (*Gain = G4 - C(t6, t1)) > 0) {
@@ -76,7 +76,7 @@ Node *Best5OptMove(Node * t1, Node * t2, GainType * G0, GainType * Gain)
             t4 = X4 == 1 ? PRED(t3) : SUC(t3);
             if (FixedOrCommon(t3, t4))
                 continue;
-            G2 = G1 + C(t3, t4);
+            G2 = G1 + TOUR_COST(t3, t4);
             if (X4 == 1 &&
                 !Forbidden(t4, t1) &&
                 (!c || G2 - c(t4, t1) > 0) && (*Gain = G2 - C(t4, t1)) > 0)
@@ -121,7 +121,7 @@ Node *Best5OptMove(Node * t1, Node * t2, GainType * G0, GainType * Gain)
                     }
                     if (FixedOrCommon(t5, t6))
                         continue;
-                    G4 = G3 + C(t5, t6);
+                    G4 = G3 + TOUR_COST(t5, t6);
                     if ((Case6 <= 2 || Case6 == 5 || Case6 == 6) &&
                         !Forbidden(t6, t1) &&
                         (!c || G4 - c(t6, t1) > 0) &&
@@ -218,7 +218,7 @@ Node *Best5OptMove(Node * t1, Node * t2, GainType * G0, GainType * Gain)
                             if (Case6 == 8 && !BTW273
                                 && !BETWEEN(t4, t7, t5))
                                 break;
-                            G6 = G5 + C(t7, t8);
+                            G6 = G5 + TOUR_COST(t7, t8);
                             if (t8 != t1 &&
                                 (Case6 == 3 ? BTW574 :
                                  Case6 == 4 ? !BTW671 :
@@ -494,7 +494,7 @@ Node *Best5OptMove(Node * t1, Node * t2, GainType * G0, GainType * Gain)
                                         continue;
                                     if (FixedOrCommon(t9, t10))
                                         continue;
-                                    G8 = G7 + C(t9, t10);
+                                    G8 = G7 + TOUR_COST(t9, t10);
                                     if (!Forbidden(t10, t1) &&
                                         (!c || G8 - c(t10, t1) > 0) &&
                                         (*Gain = G8 - C(t10, t1)) > 0) {
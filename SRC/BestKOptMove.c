@@ -100,7 +100,7 @@ static GainType BestKOptMoveRec(int k, GainType G0)
             if (FixedOrCommon(t3, t4) || Deleted(t3, t4))
                 continue;
             t[2 * k] = t4;
-            G2 = G1 + C(t3, t4);
+            G2 = G1 + TOUR_COST(t3, t4);
             G3 = MINUS_INFINITY;
             if (t4 != t1 && !Forbidden(t4, t1) && !Added(t4, t1) &&
                 (!c || G2 - c(t4, t1) > 0) &&
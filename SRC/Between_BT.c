@@ -0,0 +1,36 @@
+#include "LKH.h"
+
+/*
+ * The Between_BT function is used to determine whether a node is 
+ * between two other nodes with respect to the current orientation. 
+ * The function is only used if the balanced tree representation 
+ * is used for a tour.
+ * 	
+ * Between_BT(a,b,c) returns 1 if node b is between node a and c.
+ * Otherwise, 0 is returned.
+ *
+ * The positions of the three nodes in the tree are determined in 
+ * O(log n) expected time (see BTree.c).
+ * 	
+ * The function is called from the functions BestMove, Gain23,
+ * BridgeGain, Make4OptMove, Make5OptMove and FindPermutation.
+ */
+
+int Between_BT(const Node * ta, const Node * tb, const Node * tc)
+{
+    int a, b, c;
+
+    if (tb == ta || tb == tc)
+        return 1;
+    if (ta == tc)
+        return 0;
+    b = Position_BT(tb);
+    if (!Reversed) {
+        a = Position_BT(ta);
+        c = Position_BT(tc);
+    } else {
+        a = Position_BT(tc);
+        c = Position_BT(ta);
+    }
+    return a <= c ? b >= a && b <= c : b >= a || b <= c;
+}
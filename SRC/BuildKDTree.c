@@ -16,6 +16,9 @@ static int cutoff;
  * See
  *    Jon Louis Bentley: K-d Trees for Semidynamic Point Sets. 
  *    Symposium on Computational Geometry 1990: 187-197
+ *
+ * The tree is allocated from ScratchArena. The caller must release it
+ * (by ReleaseArena).
  */
 
 Node **BuildKDTree(int Cutoff)
@@ -24,7 +27,7 @@ Node **BuildKDTree(int Cutoff)
     Node *N;
 
     cutoff = Cutoff >= 1 ? Cutoff : 1;
-    assert(KDTree = (Node **) malloc(Dimension * sizeof(Node *)));
+    KDTree = (Node **) ArenaAlloc(&ScratchArena, Dimension * sizeof(Node *));
     for (i = 0, N = FirstNode; i < Dimension; i++, N = N->Suc)
         KDTree[i] = N;
     BuildSubKDTree(0, Dimension - 1);
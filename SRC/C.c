@@ -13,6 +13,32 @@ int C_EXPLICIT(Node * Na, Node * Nb)
     return Na->Id < Nb->Id ? Nb->C[Na->Id] : Na->C[Nb->Id];
 }
 
+/*
+ * The C_EXPLICIT_8 and C_EXPLICIT_16 functions are used instead of
+ * C_EXPLICIT when the cost matrix is stored with 8-bit or 16-bit entries,
+ * and C_EXPLICIT_32 is used when a matrix with 32-bit entries has been
+ * mapped from a file (see CostMatrix.c). The entries are not transformed
+ * in place, so the offset, Precision and the Pi-values are applied here.
+ */
+
+int C_EXPLICIT_8(Node * Na, Node * Nb)
+{
+    return (CostMatrixOffset + CostMatrix8[CostIndex(Na->Id, Nb->Id)]) *
+        Precision + Na->Pi + Nb->Pi;
+}
+
+int C_EXPLICIT_16(Node * Na, Node * Nb)
+{
+    return (CostMatrixOffset + CostMatrix16[CostIndex(Na->Id, Nb->Id)]) *
+        Precision + Na->Pi + Nb->Pi;
+}
+
+int C_EXPLICIT_32(Node * Na, Node * Nb)
+{
+    return (Na->Id < Nb->Id ? Nb->C[Na->Id] : Na->C[Nb->Id]) * Precision +
+        Na->Pi + Nb->Pi;
+}
+
 /*
  * The C_FUNCTION function is used when the distance is defined by a
  * function (e.g. the Euclidean distance function). In order to speed
@@ -21,18 +47,25 @@ int C_EXPLICIT(Node * Na, Node * Nb)
  *  (1) If (Na,Nb) is an edge on the current tour, then its distance
  *      is available in either the field PredCost or SucCost.
  *
- *  (2) A hash table (CacheVal) is consulted to see if the distance has
- *      been stored.
+ *  (2) A set-associative cache (DistanceCache) is consulted to see if the 
+ *      distance has been stored. The edge is hashed (by multiplicative
+ *      hashing of its packed node numbers) to a set of CACHE_WAYS entries.
  *
  *  (3) Otherwise the distance function is called and the distance computed
- *      is stored in the hash table.
+ *      is stored in the first entry of the set. The other entries are 
+ *      shifted one position, and the last one is discarded.
+ *
+ * The number of hits and misses in the cache are counted in CacheHits and
+ * CacheMisses.
  */
 //这个函数永远不会被运行
 int C_FUNCTION(Node * Na, Node * Nb)
 {
     Node *Nc;
     Candidate *Cand;
-    int Index, i, j;
+    CacheSet *Set;
+    unsigned long long Key;
+    int i, j, w;
 
     if (PredSucCostAvailable) {
         if (Na->Suc == Nb)
@@ -44,11 +77,11 @@ int C_FUNCTION(Node * Na, Node * Nb)
         for (; (Nc = Cand->To); Cand++)
             if (Nc == Nb)
                 return Cand->Cost;
-    if ((Cand = Na->BackboneCandidateSet))
+    if (BackboneCandidateTable && (Cand = BackboneCandidateSet(Na)))
         for (; (Nc = Cand->To); Cand++)
             if (Nc == Nb)
                 return Cand->Cost;
-    if (CacheSig == 0)
+    if (DistanceCache == 0)
         return D(Na, Nb);
     i = Na->Id;
     j = Nb->Id;
@@ -57,11 +90,22 @@ int C_FUNCTION(Node * Na, Node * Nb)
         i = j;
         j = k;
     }
-    Index = ((i << 8) + i + j) & CacheMask;
-    if (CacheSig[Index] == i)
-        return CacheVal[Index];
-    CacheSig[Index] = i;
-    return (CacheVal[Index] = D(Na, Nb));
+    Key = (unsigned long long) i << 32 | (unsigned) j;
+    Set = &DistanceCache[(unsigned) ((Key * 0x9E3779B97F4A7C15ULL) >> 32) &
+                         CacheMask];
+    for (w = 0; w < CACHE_WAYS; w++) {
+        if (Set->Tag[w] == Key) {
+            CacheHits++;
+            return Set->Val[w];
+        }
+    }
+    CacheMisses++;
+    for (w = CACHE_WAYS - 1; w > 0; w--) {
+        Set->Tag[w] = Set->Tag[w - 1];
+        Set->Val[w] = Set->Val[w - 1];
+    }
+    Set->Tag[0] = Key;
+    return (Set->Val[0] = D(Na, Nb));
 }
 //这个函数返回的内部构造和C_EXPLICIT()一样，区别在于它返回的值要带上节点a和节点b的Pi值
 int D_EXPLICIT(Node * Na, Node * Nb)
@@ -69,6 +113,24 @@ int D_EXPLICIT(Node * Na, Node * Nb)
     return (Na->Id <
             Nb->Id ? Nb->C[Na->Id] : Na->C[Nb->Id]) + Na->Pi + Nb->Pi;
 }
+
+int D_EXPLICIT_8(Node * Na, Node * Nb)
+{
+    return (CostMatrixOffset + CostMatrix8[CostIndex(Na->Id, Nb->Id)]) *
+        Precision + Na->Pi + Nb->Pi;
+}
+
+int D_EXPLICIT_16(Node * Na, Node * Nb)
+{
+    return (CostMatrixOffset + CostMatrix16[CostIndex(Na->Id, Nb->Id)]) *
+        Precision + Na->Pi + Nb->Pi;
+}
+
+int D_EXPLICIT_32(Node * Na, Node * Nb)
+{
+    return (Na->Id < Nb->Id ? Nb->C[Na->Id] : Na->C[Nb->Id]) * Precision +
+        Na->Pi + Nb->Pi;
+}
 // 这个函数永远不会被运行
 int D_FUNCTION(Node * Na, Node * Nb)
 {
@@ -123,6 +185,40 @@ int c_EUC_3D(Node * Na, Node * Nb)
     return dx * Precision + Na->Pi + Nb->Pi;
 }
 
+/* The bounds for MAN and MAX use fewer coordinates than the distances */
+
+int c_MAN_2D(Node * Na, Node * Nb)
+{
+    int dx = (int) (fabs(Na->X - Nb->X) + 0.5),
+        dy = (int) (fabs(Na->Y - Nb->Y) + 0.5);
+    return (dx > dy ? dx : dy) * Precision + Na->Pi + Nb->Pi;
+}
+
+int c_MAN_3D(Node * Na, Node * Nb)
+{
+    int dx = (int) (fabs(Na->X - Nb->X) + 0.5),
+        dy = (int) (fabs(Na->Y - Nb->Y) + 0.5),
+        dz = (int) (fabs(Na->Z - Nb->Z) + 0.5);
+    if (dy > dx)
+        dx = dy;
+    if (dz > dx)
+        dx = dz;
+    return dx * Precision + Na->Pi + Nb->Pi;
+}
+
+int c_MAX_2D(Node * Na, Node * Nb)
+{
+    int dx = (int) (fabs(Na->X - Nb->X) + 0.5);
+    return dx * Precision + Na->Pi + Nb->Pi;
+}
+
+int c_MAX_3D(Node * Na, Node * Nb)
+{
+    int dx = (int) (fabs(Na->X - Nb->X) + 0.5),
+        dy = (int) (fabs(Na->Y - Nb->Y) + 0.5);
+    return (dx > dy ? dx : dy) * Precision + Na->Pi + Nb->Pi;
+}
+
 #define PI 3.141592
 #define RRR 6378.388
 
@@ -163,3 +259,21 @@ int c_GEOM_MEEUS(Node * Na, Node * Nb)
     int dx = (int) (M_RRR * M_PI / 180.0 * fabs(Na->X - Nb->X) * f + 0.5);
     return dx * Precision + Na->Pi + Nb->Pi;
 }
+
+/* The bounds for XRAY1 and XRAY2 ignore the (periodic) X-coordinate */
+
+int c_XRAY1(Node * Na, Node * Nb)
+{
+    double distc = fabs(Na->Y - Nb->Y);
+    double distt = fabs(Na->Z - Nb->Z);
+    int dx = (int) (100 * (distc > distt ? distc : distt) + 0.5);
+    return dx * Precision + Na->Pi + Nb->Pi;
+}
+
+int c_XRAY2(Node * Na, Node * Nb)
+{
+    double distc = fabs(Na->Y - Nb->Y) / 1.5;
+    double distt = fabs(Na->Z - Nb->Z) / 1.15;
+    int dx = (int) (100 * (distc > distt ? distc : distt) + 0.5);
+    return dx * Precision + Na->Pi + Nb->Pi;
+}
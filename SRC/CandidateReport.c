@@ -44,7 +44,7 @@ void CandidateReport()
         Count = 0;
         N = FirstNode;
         do
-            if (IsCommonEdge(N, N->MergeSuc[0]))
+            if (IsCommonEdge(N, MergeSuc(N, 0)))
                 Count++;
         while ((N = N->Suc) != FirstNode);
         printff("Edges.common = %d\n", Count);
@@ -0,0 +1,303 @@
+#include "LKH.h"
+#include "Genetic.h"
+
+/*
+ * The functions in this file write and read checkpoints of the search, so
+ * that a long series of runs may be continued after the program has been
+ * stopped.
+ *
+ * The WriteCheckpoint function is called from LKHmain after every
+ * CHECKPOINT_INTERVAL runs, and after the last run (InRun = 0), and from
+ * FindTour after every CHECKPOINT_TRIALS trials of a run (InRun = 1). It
+ * writes the state of the search to CHECKPOINT_FILE: the run and trial
+ * numbers, the seed
+ * and the state of the random number generator, the best tours, the
+ * current tour, the Pi-values, the minimum spanning tree (the Dad fields,
+ * which are used by the Near macro), the candidate sets, the successor tables
+ * of the initial and input tours, the segment sizes, the node and the
+ * orientation at which Gain23 continues its search, the population of the
+ * genetic algorithm, and the statistics. The numbers are written as they
+ * are stored in memory (in the native byte order). The file is first
+ * written under a temporary name, and then renamed, so that an interrupted
+ * write does not destroy the previous checkpoint.
+ *
+ * Between two runs, this is the complete state of the search. Within a
+ * run, the checkpoint also contains the time used by the run, the BestSuc
+ * and NextBestSuc fields of the nodes (the two best tours of the run), and
+ * the hash table of tours. The adjustments of the candidate sets are
+ * included in the candidate sets. At the start of a run, this state is
+ * initialized by FindTour.
+ *
+ * If RESUME is YES and CHECKPOINT_FILE exists, the ReadCheckpoint function
+ * restores the state and returns 1; otherwise it returns 0. The ascent and
+ * the creation of the candidate sets are then skipped. If the checkpoint
+ * was written within a run, ResumeTrial is set to the last completed
+ * trial, and FindTour continues the run with the next trial; otherwise,
+ * LKHmain continues with the run following the last completed one. The
+ * tours found are the same as those of an uninterrupted execution (only
+ * the times and the statistics of the distance cache, which is not saved,
+ * may differ). The checkpoint must have been written for the same problem
+ * and parameters, and on a machine with the same byte order. RUNS may be
+ * increased in order to continue an execution that has completed its
+ * runs. For this purpose, the crossover of the genetic algorithm is also
+ * made after the last run when CHECKPOINT_FILE is given.
+ *
+ * Checkpoints are not used when the problem is solved by partitioning
+ * (SUBPROBLEM_SIZE > 0).
+ */
+
+#define CHECKPOINT_HEADER "LKH checkpoint 2\n"
+
+static void Get(FILE * f, void *v, size_t Size);
+static Node *GetNode(FILE * f, int Zero);
+static void WriteSuccessors(FILE * f, Node ** Table);
+static Node **ReadSuccessors(FILE * f, Node ** Table);
+
+#define Put(x) fwrite(&(x), sizeof(x), 1, f)
+
+void WriteCheckpoint(int InRun, double RunTime)
+{
+    FILE *f;
+    char *TempName;
+    Node *N;
+    Candidate *NN;
+    int i, j, Id, Count, MaxRow = 0, *Row = 0;
+
+    if (!CheckpointFileName)
+        return;
+    assert(TempName = (char *) malloc(strlen(CheckpointFileName) + 5));
+    sprintf(TempName, "%s.tmp", CheckpointFileName);
+    if (!(f = fopen(TempName, "wb")))
+        eprintf("Cannot open CHECKPOINT_FILE: \"%s\"", TempName);
+    if (TraceLevel >= 1)
+        printff("Writing CHECKPOINT_FILE: \"%s\" ... ", CheckpointFileName);
+    fputs(CHECKPOINT_HEADER, f);
+    Put(Dimension);
+    Put(ProblemType);
+    Put(Precision);
+    Put(Run);
+    Put(Trial);
+    Put(Seed);
+    Put(Norm);
+    Put(LowerBound);
+    Put(BestCost);
+    Put(BetterCost);
+    Put(Optimum);
+    fwrite(BestTour, sizeof(int), 1 + Dimension, f);
+    fwrite(BetterTour, sizeof(int), 1 + Dimension, f);
+    N = FirstNode;
+    do
+        Put(N->Id);
+    while ((N = N->Suc) != FirstNode);
+    for (i = 1; i <= Dimension; i++) {
+        N = &NodeSet[i];
+        Count = 0;
+        for (NN = N->CandidateSet; NN && NN->To; NN++)
+            Count++;
+        if (3 + 3 * Count > MaxRow) {
+            free(Row);
+            assert(Row = (int *) malloc((MaxRow = 3 + 3 * Count) *
+                                        sizeof(int)));
+        }
+        Row[0] = N->Pi;
+        Row[1] = N->Dad ? N->Dad->Id : 0;
+        Row[2] = Count;
+        for (j = 3, NN = N->CandidateSet; NN && NN->To; NN++) {
+            Row[j++] = NN->To->Id;
+            Row[j++] = NN->Cost;
+            Row[j++] = NN->Alpha;
+        }
+        fwrite(Row, sizeof(int), j, f);
+    }
+    free(Row);
+    WriteSuccessors(f, InitialSucTable);
+    WriteSuccessors(f, InputSucTable);
+    Put(GroupSize);
+    Put(SGroupSize);
+    Put(FlipSampling);
+    Id = Gain23Node ? Gain23Node->Id : 0;
+    Put(Id);
+    Put(Gain23Reversed);
+    WriteRandomState(f);
+    WriteStatistics(f);
+    WritePopulation(f);
+    Put(InRun);
+    if (InRun) {
+        Put(RunTime);
+        for (i = 1; i <= Dimension; i++) {
+            N = &NodeSet[i];
+            Id = N->BestSuc ? N->BestSuc->Id : 0;
+            Put(Id);
+            Id = N->NextBestSuc ? N->NextBestSuc->Id : 0;
+            Put(Id);
+        }
+        fwrite(HTable, sizeof(HashTable), 1, f);
+    }
+    if (ferror(f) || fclose(f) || rename(TempName, CheckpointFileName))
+        eprintf("Cannot write CHECKPOINT_FILE: \"%s\"", CheckpointFileName);
+    free(TempName);
+    if (TraceLevel >= 1)
+        printff("done\n");
+}
+
+#define Check(Condition)\
+    if (!(Condition))\
+        eprintf("CHECKPOINT_FILE \"%s\" does not match problem",\
+                CheckpointFileName)
+
+int ReadCheckpoint()
+{
+    FILE *f;
+    Node *N, *Prev;
+    Candidate *NN;
+    int i, j, Count, Value, OldGroupSize, OldSGroupSize, InRun;
+
+    if (!Resume || !CheckpointFileName ||
+        !(f = OpenInputFile(CheckpointFileName)))
+        return 0;
+    if (TraceLevel >= 1)
+        printff("Reading CHECKPOINT_FILE: \"%s\" ... ", CheckpointFileName);
+    Check(ReadInputHeader(f, CHECKPOINT_HEADER));
+    Get(f, &Value, sizeof(int));
+    Check(Value == Dimension);
+    Get(f, &Value, sizeof(int));
+    Check(Value == ProblemType);
+    Get(f, &Value, sizeof(int));
+    Check(Value == Precision);
+    Get(f, &Run, sizeof(Run));
+    Get(f, &Trial, sizeof(Trial));
+    Get(f, &Seed, sizeof(Seed));
+    Get(f, &Norm, sizeof(Norm));
+    Get(f, &LowerBound, sizeof(LowerBound));
+    Get(f, &BestCost, sizeof(BestCost));
+    Get(f, &BetterCost, sizeof(BetterCost));
+    Get(f, &Optimum, sizeof(Optimum));
+    Get(f, BestTour, (1 + Dimension) * sizeof(int));
+    Get(f, BetterTour, (1 + Dimension) * sizeof(int));
+    FirstNode = Prev = GetNode(f, 0);
+    for (i = 2; i <= Dimension; i++) {
+        N = GetNode(f, 0);
+        Link(Prev, N);
+        Prev = N;
+    }
+    Link(Prev, FirstNode);
+    for (i = 1; i <= Dimension; i++) {
+        N = &NodeSet[i];
+        Get(f, &N->Pi, sizeof(int));
+        N->Dad = GetNode(f, 1);
+        Get(f, &Count, sizeof(int));
+        Check(Count >= 0 && Count < Dimension);
+        free(N->CandidateSet);
+        assert(N->CandidateSet =
+               (Candidate *) calloc(Count + 1, sizeof(Candidate)));
+        for (j = 0, NN = N->CandidateSet; j < Count; j++, NN++) {
+            NN->To = GetNode(f, 0);
+            Get(f, &NN->Cost, sizeof(int));
+            Get(f, &NN->Alpha, sizeof(int));
+        }
+    }
+    InitialSucTable = ReadSuccessors(f, InitialSucTable);
+    InputSucTable = ReadSuccessors(f, InputSucTable);
+    OldGroupSize = GroupSize;
+    OldSGroupSize = SGroupSize;
+    Get(f, &GroupSize, sizeof(int));
+    Get(f, &SGroupSize, sizeof(int));
+    Get(f, &FlipSampling, sizeof(int));
+    Check(GroupSize > 0 && SGroupSize > 0);
+    if (GroupSize != OldGroupSize || SGroupSize != OldSGroupSize)
+        PartitionSegments();
+    Gain23Node = GetNode(f, 1);
+    Get(f, &Gain23Reversed, sizeof(int));
+    Check(ReadRandomState(f));
+    Check(ReadStatistics(f));
+    Check(ReadPopulation(f));
+    Get(f, &InRun, sizeof(int));
+    ResumeTrial = 0;
+    ResumeTime = 0;
+    if (InRun) {
+        Check(Trial >= 1 && Trial < MaxTrials);
+        ResumeTrial = Trial;
+        Get(f, &ResumeTime, sizeof(double));
+        for (i = 1; i <= Dimension; i++) {
+            N = &NodeSet[i];
+            N->BestSuc = GetNode(f, 1);
+            N->NextBestSuc = GetNode(f, 1);
+        }
+        Get(f, HTable, sizeof(HashTable));
+        Check(HTable->Count >= 0 && HTable->Count <= HashTableSize);
+    }
+    CloseInputFile(f);
+    if (C == C_EXPLICIT) {
+        /* As in CreateCandidateSet */
+        N = FirstNode;
+        do
+            for (i = 1; i < N->Id; i++)
+                N->C[i] = N->C[i] * Precision + N->Pi + NodeSet[i].Pi;
+        while ((N = N->Suc) != FirstNode);
+    }
+    if (TraceLevel >= 1) {
+        printff("done\n");
+        if (ResumeTrial)
+            printff("Resuming run %d after trial %d\n", Run, Trial);
+        else
+            printff("Resuming after run %d\n", Run);
+    }
+    return 1;
+}
+
+/*
+ * The Get function reads Size bytes from the checkpoint file.
+ */
+
+static void Get(FILE * f, void *v, size_t Size)
+{
+    Check(ReadInputBytes(f, v, Size));
+}
+
+/*
+ * The GetNode function reads a node number from the checkpoint file, and
+ * returns the node. If Zero is nonzero, the number 0 is allowed and
+ * represents no node.
+ */
+
+static Node *GetNode(FILE * f, int Zero)
+{
+    int Id;
+
+    Get(f, &Id, sizeof(int));
+    Check(Id >= !Zero && Id <= Dimension);
+    return Id ? &NodeSet[Id] : 0;
+}
+
+/*
+ * The WriteSuccessors function writes a table of successors (e.g.,
+ * InitialSucTable). The ReadSuccessors function reads the table, and
+ * returns it (allocated, if Table is 0, and the table was not empty).
+ */
+
+static void WriteSuccessors(FILE * f, Node ** Table)
+{
+    int i, Id, Exists = Table != 0;
+
+    Put(Exists);
+    if (!Exists)
+        return;
+    for (i = 1; i <= Dimension; i++) {
+        Id = Table[i] ? Table[i]->Id : 0;
+        Put(Id);
+    }
+}
+
+static Node **ReadSuccessors(FILE * f, Node ** Table)
+{
+    int i, Exists;
+
+    Get(f, &Exists, sizeof(int));
+    if (!Exists)
+        return Table;
+    if (!Table)
+        Table = (Node **) AllocateNodeTable(sizeof(Node *));
+    for (i = 1; i <= Dimension; i++)
+        Table[i] = GetNode(f, 1);
+    return Table;
+}
@@ -61,7 +61,9 @@ void ChooseInitialTour()
         return;
     }
     // 无意义
-    if (Trial == 1 && (!FirstNode->InitialSuc || InitialTourFraction < 1)) {
+    if (Trial == 1 &&
+        (!InitialSucTable || !InitialSuc(FirstNode) ||
+         InitialTourFraction < 1)) {
         // 不会进入
         if (InitialTourAlgorithm == BORUVKA ||
                 InitialTourAlgorithm == GREEDY ||
@@ -76,7 +78,7 @@ void ChooseInitialTour()
                 BetterCost = Cost;
                 RecordBetterTour();
             }
-            if (!FirstNode->InitialSuc)
+            if (!InitialSucTable || !InitialSuc(FirstNode))
                 return;
         }
     }
@@ -153,7 +155,8 @@ Start:
         Case B：如果Tria=1(这里的Trial会从1开始不断变大),就尽可能让(N,NextN)是初始解上的一条边(无法找到)
         */
         // 不会进入
-        if (Alternatives == 0 && FirstNode->InitialSuc && Trial == 1 &&
+        if (Alternatives == 0 && InitialSucTable && InitialSuc(FirstNode) &&
+                Trial == 1 &&
                 Count <= InitialTourFraction * Dimension) {
             for (NN = N->CandidateSet; (NextN = NN->To); NN++) {
                 if (!NextN->V && InInitialTour(N, NextN)) {
@@ -0,0 +1,93 @@
+#include "LKH.h"
+
+/*
+ * The ChooseTreeType function chooses the tour representation to be used
+ * for the current problem (or subproblem).
+ *
+ * If TREE_TYPE has been specified, that representation is used. Otherwise,
+ * the representation is chosen from the dimension of the problem: the
+ * array representation is used for small and medium-sized problems, the 
+ * three-level tree representation for very large problems, and the 
+ * two-level tree representation for all other problems.
+ *
+ * The functions that depend on the representation are compiled once for
+ * each representation (see Segment.h). ChooseTreeType binds the move
+ * functions (BestMove and BestSubsequentMove) to the copies for the chosen
+ * representation. The LinKernighan function below dispatches to the copy
+ * of LinKernighan for the chosen representation. In this way all calls made
+ * during the local search go directly to the specialized functions.
+ *
+ * The function is called from the AllocateSegments function.
+ */
+
+#define ARRAY_MAX_DIMENSION 5000
+#define TWO_LEVEL_MAX_DIMENSION 1000000
+
+#define DeclareTreeFunctions(S)\
+    GainType LinKernighan##S(void);\
+    Node *Best2OptMove##S(Node * t1, Node * t2, GainType * G0,\
+                          GainType * Gain);\
+    Node *Best3OptMove##S(Node * t1, Node * t2, GainType * G0,\
+                          GainType * Gain);\
+    Node *Best4OptMove##S(Node * t1, Node * t2, GainType * G0,\
+                          GainType * Gain);\
+    Node *Best5OptMove##S(Node * t1, Node * t2, GainType * G0,\
+                          GainType * Gain);\
+    Node *BestKOptMove##S(Node * t1, Node * t2, GainType * G0,\
+                          GainType * Gain)
+
+DeclareTreeFunctions(_LL);
+DeclareTreeFunctions(_SL);
+DeclareTreeFunctions(_SSL);
+DeclareTreeFunctions(_A);
+DeclareTreeFunctions(_BT);
+
+static MoveFunction BestOptMove[5][6] = {
+    {0, 0, Best2OptMove_LL, Best3OptMove_LL, Best4OptMove_LL,
+     Best5OptMove_LL},
+    {0, 0, Best2OptMove_SL, Best3OptMove_SL, Best4OptMove_SL,
+     Best5OptMove_SL},
+    {0, 0, Best2OptMove_SSL, Best3OptMove_SSL, Best4OptMove_SSL,
+     Best5OptMove_SSL},
+    {0, 0, Best2OptMove_A, Best3OptMove_A, Best4OptMove_A,
+     Best5OptMove_A},
+    {0, 0, Best2OptMove_BT, Best3OptMove_BT, Best4OptMove_BT,
+     Best5OptMove_BT}
+};
+
+static MoveFunction BestKOptMoveFunction[5] = {
+    BestKOptMove_LL, BestKOptMove_SL, BestKOptMove_SSL, BestKOptMove_A,
+    BestKOptMove_BT
+};
+
+void ChooseTreeType()
+{
+    CurrentTreeType =
+        TreeType != -1 ? TreeType :
+        Dimension <= ARRAY_MAX_DIMENSION ? ARRAY_TOUR :
+        Dimension <= TWO_LEVEL_MAX_DIMENSION ? TWO_LEVEL_LIST :
+        THREE_LEVEL_LIST;
+    if (PatchingC >= 1 && NonsequentialMoveType >= 4) {
+        BestMove = BestSubsequentMove =
+            BestKOptMoveFunction[CurrentTreeType];
+        if (!SubsequentPatching && SubsequentMoveType <= 5)
+            BestSubsequentMove =
+                BestOptMove[CurrentTreeType][SubsequentMoveType];
+    } else {
+        BestMove = MoveType <= 5 ?
+            BestOptMove[CurrentTreeType][MoveType] :
+            BestKOptMoveFunction[CurrentTreeType];
+        BestSubsequentMove = SubsequentMoveType <= 5 ?
+            BestOptMove[CurrentTreeType][SubsequentMoveType] :
+            BestKOptMoveFunction[CurrentTreeType];
+    }
+}
+
+GainType LinKernighan()
+{
+    return CurrentTreeType == ARRAY_TOUR ? LinKernighan_A() :
+        CurrentTreeType == ONE_LEVEL_LIST ? LinKernighan_LL() :
+        CurrentTreeType == TWO_LEVEL_LIST ? LinKernighan_SL() :
+        CurrentTreeType == THREE_LEVEL_LIST ? LinKernighan_SSL() :
+        LinKernighan_BT();
+}
@@ -0,0 +1,84 @@
+#include "LKH.h"
+
+/*
+ * The ComputeTrigTerms function computes the trigonometric terms used by
+ * the distance functions for geographical coordinates (GEO, GEOM,
+ * GEO_MEEUS and GEOM_MEEUS).
+ *
+ * The latitude and longitude of each node are converted to radians, and
+ * their sines and cosines (and those of their halves) are computed once.
+ * The distance functions then need no conversions, and the trigonometric
+ * functions of sums and differences of angles are computed by means of
+ * the addition formulas. Only acos, atan2 or atan (and sqrt) remain to be
+ * called for each distance.
+ *
+ * The terms are stored in the table Trig, which is indexed by node number
+ * (for HPP instances it includes the extra node).
+ * The terms of nodes that do not belong to NodeSet (Id zero) are computed 
+ * by the distance functions when needed (see NodeTrigTerms).
+ *
+ * The function is called from the ReadProblem function. It must be called
+ * again for the nodes of the current problem (or subproblem) whenever their
+ * coordinates have been changed, as is done when candidate sets are
+ * created for longitudes transformed by 180 degrees.
+ */
+
+#define PI 3.141592
+#undef M_PI
+#define M_PI 3.14159265358979323846264
+
+void ComputeTrigTerms()
+{
+    Node *N;
+    int Nodes = DimensionSaved + (ProblemType == HPP);
+
+    if (!FirstNode ||
+        (Distance != Distance_GEO && Distance != Distance_GEOM &&
+         Distance != Distance_GEO_MEEUS && Distance != Distance_GEOM_MEEUS))
+        return;
+    if (!Trig)
+        Trig = (TrigTerms *) LargeCalloc(Nodes + 1, sizeof(TrigTerms));
+    N = FirstNode;
+    do
+        NodeTrigTerms(N, &Trig[N->Id]);
+    while ((N = N->Suc) != FirstNode);
+}
+
+/*
+ * The NodeTrigTerms function computes the trigonometric terms of a given
+ * node. It is also used by the distance functions for nodes that do not
+ * belong to NodeSet (e.g., cluster centers), which have Id zero.
+ *
+ * The conversion of the coordinates is chosen from the distance function,
+ * since WeightType is EXPLICIT when a cost matrix has been computed from
+ * the coordinates.
+ */
+
+void NodeTrigTerms(Node * N, TrigTerms * T)
+{
+    int deg;
+    double min;
+
+    if (Distance == Distance_GEO) {
+        deg = (int) N->X;
+        min = N->X - deg;
+        T->Lat = PI * (deg + 5.0 * min / 3.0) / 180.0;
+        deg = (int) N->Y;
+        min = N->Y - deg;
+        T->Lon = PI * (deg + 5.0 * min / 3.0) / 180.0;
+    } else if (Distance == Distance_GEO_MEEUS) {
+        T->Lat = M_PI * ((int) N->X + 5 * (N->X - (int) N->X) / 3) / 180;
+        T->Lon = M_PI * ((int) N->Y + 5 * (N->Y - (int) N->Y) / 3) / 180;
+    } else {
+        T->Lat = M_PI * (N->X / 180);
+        T->Lon = M_PI * (N->Y / 180);
+    }
+    T->SinLat = sin(T->Lat);
+    T->CosLat = cos(T->Lat);
+    T->SinLon = sin(T->Lon);
+    T->CosLon = cos(T->Lon);
+    T->SinHalfLat = sin(T->Lat / 2);
+    T->CosHalfLat = cos(T->Lat / 2);
+    T->SinHalfLon = sin(T->Lon / 2);
+    T->CosHalfLon = cos(T->Lon / 2);
+}
@@ -0,0 +1,368 @@
+#include "LKH.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ * The functions in this file are used for storing a symmetric cost matrix,
+ * possibly with narrow entries.
+ *
+ * The lower triangle of the matrix is stored row by row. Normally each
+ * entry is an int, and row i is referenced by the field C of node i.
+ * If COST_MATRIX_WIDTH is 8 or 16, the entries are stored as unsigned
+ * chars or unsigned shorts (in CostMatrix8 or CostMatrix16, indexed by
+ * CostIndex), and each weight W is stored as W - CostMatrixOffset. In this
+ * case the entries are never changed by the search: Precision and the
+ * Pi-values are applied each time an entry is read (see C_EXPLICIT_8 and
+ * C_EXPLICIT_16).
+ *
+ * The matrix is filled by calls of StoreCost with CostMatrixOffset equal
+ * to zero. If a weight does not fit into the current width, the matrix is
+ * widened. When all weights have been stored, CompressCostMatrix chooses
+ * CostMatrixOffset as the smallest weight, which may make it possible to
+ * store the matrix with fewer bits. If the matrix is widened after the
+ * readers C, D and Distance have been chosen, they are changed to match.
+ *
+ * If COST_MATRIX_FILE is specified, the matrix is kept in a binary file
+ * between runs. The file consists of a header of HEADER_SIZE bytes
+ * followed by the entries of the matrix, exactly as they are stored in
+ * memory (in the native byte order). Since the rows follow the internal
+ * node numbers, the header also records NODE_ORDER. If the file exists,
+ * it is mapped into memory by ReadCostMatrix; otherwise the matrix is
+ * written to it by WriteCostMatrix. A mapped matrix is private to the
+ * process, but its pages are read from the file on demand and may be
+ * shared with other processes using the same file. Since in-place
+ * transformation of the entries would copy every page, the entries of a
+ * mapped matrix with 32 bits are read by C_EXPLICIT_32 and D_EXPLICIT_32
+ * (which, like C_EXPLICIT_8 and C_EXPLICIT_16, apply Precision and the
+ * Pi-values).
+ * A matrix stored in a BINARY_PROBLEM_FILE is mapped in the same way (see
+ * MapCostMatrix).
+ */
+
+#define HEADER_SIZE 64
+#define MAGIC "LKHCOST"
+
+typedef struct Header {
+    char Magic[8];
+    int Dimension, Width, Offset, Min, Max, NodeOrder;
+} Header;
+
+static int Nodes;
+static void *Map;
+static size_t MapLength;
+
+static void Convert(int Width, int Offset);
+static void Release(void);
+static void SetRows(void);
+
+/*
+ * The AllocateCostMatrix function allocates a cost matrix for the current
+ * Dimension with the width given by CostMatrixWidth. All entries are zero.
+ */
+
+void AllocateCostMatrix()
+{
+    size_t Size;
+
+    Nodes = Dimension;
+    Size = (size_t) Nodes * (Nodes - 1) / 2;
+    CostMatrixOffset = 0;
+    if (CostMatrixWidth == 8)
+        CostMatrix8 =
+            (unsigned char *) LargeCalloc(Size, sizeof(unsigned char));
+    else if (CostMatrixWidth == 16)
+        CostMatrix16 =
+            (unsigned short *) LargeCalloc(Size, sizeof(unsigned short));
+    else
+        CostMatrix = (int *) LargeCalloc(Size, sizeof(int));
+    SetRows();
+}
+
+/*
+ * The StoreCost function sets the weight of the edge between node N and
+ * node number j (j < N->Id) to W. The matrix is widened if W does not fit.
+ */
+
+void StoreCost(Node * N, int j, int W)
+{
+    unsigned V = (unsigned) W - (unsigned) CostMatrixOffset;
+
+    if (CostMatrix8) {
+        if (V <= UCHAR_MAX) {
+            CostMatrix8[CostIndex(N->Id, j)] = (unsigned char) V;
+            return;
+        }
+        Convert(V <= USHRT_MAX ? 16 : 32, CostMatrixOffset);
+    }
+    if (CostMatrix16) {
+        if (V <= USHRT_MAX) {
+            CostMatrix16[CostIndex(N->Id, j)] = (unsigned short) V;
+            return;
+        }
+        Convert(32, 0);
+    }
+    N->C[j] = W;
+}
+
+/*
+ * The StoredCost function returns the weight of the edge between node N
+ * and node number j (j < N->Id) as stored in the matrix.
+ */
+
+int StoredCost(Node * N, int j)
+{
+    size_t k = CostIndex(N->Id, j);
+
+    return CostMatrix8 ? CostMatrixOffset + CostMatrix8[k] :
+        CostMatrix16 ? CostMatrixOffset + CostMatrix16[k] : N->C[j];
+}
+
+/*
+ * The CompressCostMatrix function stores the matrix with the smallest
+ * width allowed by CostMatrixWidth, using the smallest weight as offset.
+ *
+ * In subproblem mode the weights of some edges are temporarily set to
+ * zero (see SolveSubproblem). Zero must therefore be representable, and
+ * the offset is at most zero.
+ */
+
+void CompressCostMatrix()
+{
+    size_t Size = (size_t) Nodes * (Nodes - 1) / 2, k;
+    int Width = CostMatrix8 ? 8 : CostMatrix16 ? 16 : 32, W, Min, Max;
+    unsigned Range;
+
+    if (Size == 0 || Width == CostMatrixWidth || CostMatrixWidth == 32)
+        return;
+    Min = INT_MAX;
+    Max = INT_MIN;
+    for (k = 0; k < Size; k++) {
+        W = CostMatrix16 ? CostMatrixOffset + CostMatrix16[k] :
+            CostMatrix[k];
+        if (W < Min)
+            Min = W;
+        if (W > Max)
+            Max = W;
+    }
+    if (SubproblemSize > 0 && Min > 0)
+        Min = 0;
+    Range = (unsigned) Max - (unsigned) Min;
+    if (CostMatrixWidth == 8 && Range <= UCHAR_MAX)
+        Convert(8, Min);
+    else if (Width == 32 && Range <= USHRT_MAX)
+        Convert(16, Min);
+}
+
+/*
+ * The Convert function stores the matrix with a given width and offset.
+ * All weights must fit. If C and D have already been chosen for the
+ * current width (see ReadProblem), they are replaced by the functions for
+ * the new width. A widened matrix with 32 bits is read by C_EXPLICIT_32 and
+ * D_EXPLICIT_32, since its entries have not been transformed.
+ */
+
+static void Convert(int Width, int Offset)
+{
+    size_t Size = (size_t) Nodes * (Nodes - 1) / 2, k;
+    unsigned char *M8 = 0;
+    unsigned short *M16 = 0;
+    int *M = 0, W;
+
+    if (Width == 8)
+        M8 = (unsigned char *) LargeCalloc(Size, sizeof(unsigned char));
+    else if (Width == 16)
+        M16 = (unsigned short *) LargeCalloc(Size, sizeof(unsigned short));
+    else
+        M = (int *) LargeCalloc(Size, sizeof(int));
+    for (k = 0; k < Size; k++) {
+        W = CostMatrix8 ? CostMatrixOffset + CostMatrix8[k] :
+            CostMatrix16 ? CostMatrixOffset + CostMatrix16[k] :
+            CostMatrix[k];
+        if (M8)
+            M8[k] = (unsigned char) (W - Offset);
+        else if (M16)
+            M16[k] = (unsigned short) (W - Offset);
+        else
+            M[k] = W;
+    }
+    Release();
+    CostMatrix8 = M8;
+    CostMatrix16 = M16;
+    CostMatrix = M;
+    CostMatrixOffset = M ? 0 : Offset;
+    SetRows();
+    if (C == C_EXPLICIT_8 || C == C_EXPLICIT_16) {
+        C = M8 ? C_EXPLICIT_8 : M16 ? C_EXPLICIT_16 : C_EXPLICIT_32;
+        D = M8 ? D_EXPLICIT_8 : M16 ? D_EXPLICIT_16 : D_EXPLICIT_32;
+    }
+    if (Distance == Distance_EXPLICIT_8 || Distance == Distance_EXPLICIT_16)
+        Distance = M8 ? Distance_EXPLICIT_8 :
+            M16 ? Distance_EXPLICIT_16 : Distance_EXPLICIT;
+}
+
+/*
+ * The ReadCostMatrix function maps the matrix in COST_MATRIX_FILE into
+ * memory. If the file cannot be opened, the function returns 0;
+ * otherwise 1.
+ *
+ * In subproblem mode a file with a positive offset is not used (the
+ * function returns 0, and the matrix is computed and written anew), since
+ * zero weights must be representable (see CompressCostMatrix).
+ */
+
+int ReadCostMatrix()
+{
+    Header H;
+    struct stat Stat;
+    size_t Size;
+    int File;
+    void *Data;
+
+    if (CostMatrixFileName == 0 ||
+        (File = open(CostMatrixFileName, O_RDONLY)) == -1)
+        return 0;
+    if (read(File, &H, sizeof(H)) != sizeof(H) ||
+        strncmp(H.Magic, MAGIC, sizeof(H.Magic)) ||
+        H.Dimension != Dimension || H.NodeOrder != NodeOrder ||
+        (H.Width != 8 && H.Width != 16 && H.Width != 32))
+        eprintf("COST_MATRIX_FILE \"%s\" does not match problem",
+                CostMatrixFileName);
+    if (SubproblemSize > 0 && H.Offset > 0) {
+        close(File);
+        return 0;
+    }
+    Size = (size_t) Dimension * (Dimension - 1) / 2;
+    if (fstat(File, &Stat) ||
+        (size_t) Stat.st_size != HEADER_SIZE + Size * (H.Width / 8))
+        eprintf("COST_MATRIX_FILE \"%s\": wrong size", CostMatrixFileName);
+    if ((Data = mmap(0, (size_t) Stat.st_size, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE, File, 0)) == MAP_FAILED)
+        eprintf("COST_MATRIX_FILE \"%s\": cannot be mapped",
+                CostMatrixFileName);
+    close(File);
+    MapCostMatrix(Data, (size_t) Stat.st_size, HEADER_SIZE, H.Width,
+                  H.Offset, H.Min, H.Max);
+    return 1;
+}
+
+/*
+ * The MapCostMatrix function makes the matrix refer to the entries stored
+ * at byte Position of a mapped file (Data, Length bytes), which is
+ * unmapped when the matrix is freed. The entries have the given Width and
+ * Offset, and the weights lie between Min and Max.
+ */
+
+void MapCostMatrix(void *Data, size_t Length, size_t Position, int Width,
+                   int Offset, int Min, int Max)
+{
+    char *Base = (char *) Data + Position;
+
+    if (Precision > 1 &&
+        ((Max > 0 && Max > INT_MAX / Precision) ||
+         (Min < 0 && Min < -INT_MAX / Precision)))
+        eprintf("PRECISION (= %d) is too large", Precision);
+    Release();
+    Map = Data;
+    MapLength = Length;
+    if (Width == 8)
+        CostMatrix8 = (unsigned char *) Base;
+    else if (Width == 16)
+        CostMatrix16 = (unsigned short *) Base;
+    else
+        CostMatrix = (int *) Base;
+    CostMatrixOffset = Offset;
+    Nodes = Dimension;
+    SetRows();
+}
+
+/*
+ * The CostMatrixRange function computes the smallest and the largest
+ * weight of the matrix.
+ */
+
+void CostMatrixRange(int *Min, int *Max)
+{
+    size_t Size = (size_t) Nodes * (Nodes - 1) / 2, k;
+    int W;
+
+    *Min = INT_MAX;
+    *Max = INT_MIN;
+    for (k = 0; k < Size; k++) {
+        W = CostMatrix8 ? CostMatrixOffset + CostMatrix8[k] :
+            CostMatrix16 ? CostMatrixOffset + CostMatrix16[k] :
+            CostMatrix[k];
+        if (W < *Min)
+            *Min = W;
+        if (W > *Max)
+            *Max = W;
+    }
+}
+
+/*
+ * The WriteCostMatrix function writes the matrix to COST_MATRIX_FILE.
+ */
+
+void WriteCostMatrix()
+{
+    size_t Size = (size_t) Nodes * (Nodes - 1) / 2;
+    char Bytes[HEADER_SIZE];
+    Header H;
+    FILE *File;
+
+    if (CostMatrixFileName == 0 ||
+        !(File = fopen(CostMatrixFileName, "wb")))
+        return;
+    memset(&H, 0, sizeof(H));
+    strcpy(H.Magic, MAGIC);
+    H.Dimension = Nodes;
+    H.Width = CostMatrix8 ? 8 : CostMatrix16 ? 16 : 32;
+    H.Offset = CostMatrixOffset;
+    H.NodeOrder = NodeOrder;
+    CostMatrixRange(&H.Min, &H.Max);
+    memset(Bytes, 0, sizeof(Bytes));
+    memcpy(Bytes, &H, sizeof(H));
+    if (fwrite(Bytes, 1, sizeof(Bytes), File) != sizeof(Bytes) ||
+        fwrite(CostMatrix8 ? (void *) CostMatrix8 :
+               CostMatrix16 ? (void *) CostMatrix16 : (void *) CostMatrix,
+               H.Width / 8, Size, File) != Size)
+        eprintf("COST_MATRIX_FILE \"%s\": write error",
+                CostMatrixFileName);
+    fclose(File);
+}
+
+/*
+ * The FreeCostMatrix function frees (or unmaps) the cost matrix.
+ */
+
+void FreeCostMatrix()
+{
+    Release();
+}
+
+static void Release()
+{
+    if (Map) {
+        munmap(Map, MapLength);
+        Map = 0;
+    } else {
+        LargeFree(CostMatrix8);
+        LargeFree(CostMatrix16);
+        LargeFree(CostMatrix);
+    }
+    CostMatrix8 = 0;
+    CostMatrix16 = 0;
+    CostMatrix = 0;
+}
+
+static void SetRows()
+{
+    int i;
+
+    for (i = 2; i <= Nodes; i++) {
+        Node *N = &NodeSet[i];
+        size_t Row = (size_t) (i - 1) * (i - 2) / 2;
+        N->C = CostMatrix ? &CostMatrix[Row] - 1 : 0;
+    }
+}
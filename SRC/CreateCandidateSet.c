@@ -43,7 +43,8 @@ void CreateCandidateSet()
     // 这个if循环在默认情况下永远不会进入
     if (Distance == Distance_1 ||
             (MaxTrials == 0 &&
-             (FirstNode->InitialSuc || InitialTourAlgorithm == SIERPINSKI ||
+             ((InitialSucTable && InitialSuc(FirstNode)) ||
+              InitialTourAlgorithm == SIERPINSKI ||
               InitialTourAlgorithm == MOORE))) {
         ReadCandidates(MaxCandidates);
         AddTourCandidates();
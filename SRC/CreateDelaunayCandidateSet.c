@@ -64,7 +64,7 @@ void CreateDelaunayCandidateSet()
             /* Transform longitude (180 and -180 map to 0) */
             From = FirstNode;
             do {
-                From->Zc = From->Y;
+                Zc(From) = From->Y;
                 if (WeightType == GEO || WeightType == GEO_MEEUS)
                     From->Y =
                         (int) From->Y + 5.0 * (From->Y -
@@ -75,13 +75,15 @@ void CreateDelaunayCandidateSet()
                         (int) From->Y + 3.0 * (From->Y -
                                                (int) From->Y) / 5.0;
             } while ((From = From->Suc) != FirstNode);
+            ComputeTrigTerms();
             Level++;
             CreateDelaunayCandidateSet();
             Level--;
             From = FirstNode;
             do
-                From->Y = From->Zc;
+                From->Y = Zc(From);
             while ((From = From->Suc) != FirstNode);
+            ComputeTrigTerms();
         }
     }
     if (Level == 0) {
@@ -3,6 +3,9 @@
 /*
  * This file contains the CreateQuadrantCandidateSet function
  * and the CreateNearestNeighborCandidateSet function.
+ *
+ * The temporary arrays used by the functions (including the K-d tree) are
+ * allocated from ScratchArena.
  */
 
 static void NearestQuadrantNeighbors(Node * N, int Q, int K);
@@ -40,25 +43,26 @@ void CreateQuadrantCandidateSet(int K)
     Node *From, *To;
     Candidate *NFrom;
     int L, Q, CandPerQ, Added, Count, i;
+    ArenaMark Mark = MarkArena(&ScratchArena);
 
     if (K <= 0)
         return;
     if (TraceLevel >= 2)
         printff("Creating quadrant candidate set ... ");
     KDTree = BuildKDTree(1);
-    assert(XMin =
-           (double *) malloc((1 + DimensionSaved) * sizeof(double)));
-    assert(XMax =
-           (double *) malloc((1 + DimensionSaved) * sizeof(double)));
-    assert(YMin =
-           (double *) malloc((1 + DimensionSaved) * sizeof(double)));
-    assert(YMax =
-           (double *) malloc((1 + DimensionSaved) * sizeof(double)));
+    XMin = (double *)
+        ArenaAlloc(&ScratchArena, (1 + DimensionSaved) * sizeof(double));
+    XMax = (double *)
+        ArenaAlloc(&ScratchArena, (1 + DimensionSaved) * sizeof(double));
+    YMin = (double *)
+        ArenaAlloc(&ScratchArena, (1 + DimensionSaved) * sizeof(double));
+    YMax = (double *)
+        ArenaAlloc(&ScratchArena, (1 + DimensionSaved) * sizeof(double));
     if (CoordType == THREED_COORDS) {
-        assert(ZMin =
-               (double *) malloc((1 + DimensionSaved) * sizeof(double)));
-        assert(ZMax =
-               (double *) malloc((1 + DimensionSaved) * sizeof(double)));
+        ZMin = (double *)
+            ArenaAlloc(&ScratchArena, (1 + DimensionSaved) * sizeof(double));
+        ZMax = (double *)
+            ArenaAlloc(&ScratchArena, (1 + DimensionSaved) * sizeof(double));
     }
     ComputeBounds(0, Dimension - 1);
     Contains = CoordType == THREED_COORDS ? Contains3D : Contains2D;
@@ -66,8 +70,8 @@ void CreateQuadrantCandidateSet(int K)
         CoordType == THREED_COORDS ? BoxOverlaps3D : BoxOverlaps2D;
     L = CoordType == THREED_COORDS ? 8 : 4;
     CandPerQ = K / L;
-    assert(CandidateSet =
-           (Candidate *) malloc((K + 1) * sizeof(Candidate)));
+    CandidateSet = (Candidate *)
+        ArenaAlloc(&ScratchArena, (K + 1) * sizeof(Candidate));
 
     From = FirstNode;
     do {
@@ -95,23 +99,14 @@ void CreateQuadrantCandidateSet(int K)
         }
     } while ((From = From->Suc) != FirstNode);
 
-    free(CandidateSet);
-    free(KDTree);
-    free(XMin);
-    free(XMax);
-    free(YMin);
-    free(YMax);
-    if (CoordType == THREED_COORDS) {
-        free(ZMin);
-        free(ZMax);
-    }
+    ReleaseArena(&ScratchArena, Mark);
     if (Level == 0 &&
         (WeightType == GEO || WeightType == GEOM ||
          WeightType == GEO_MEEUS || WeightType == GEOM_MEEUS)) {
         Candidate **SavedCandidateSet;
-        assert(SavedCandidateSet =
-               (Candidate **) malloc((1 + DimensionSaved) *
-                                     sizeof(Candidate *)));
+        SavedCandidateSet = (Candidate **)
+            ArenaAlloc(&ScratchArena,
+                       (1 + DimensionSaved) * sizeof(Candidate *));
         if (TraceLevel >= 2)
             printff("done\n");
         From = FirstNode;
@@ -124,7 +119,7 @@ void CreateQuadrantCandidateSet(int K)
             do {
                 SavedCandidateSet[From->Id] = From->CandidateSet;
                 From->CandidateSet = 0;
-                From->Zc = From->Y;
+                Zc(From) = From->Y;
                 if (WeightType == GEO || WeightType == GEO_MEEUS)
                     From->Y =
                         (int) From->Y + 5.0 * (From->Y -
@@ -135,13 +130,15 @@ void CreateQuadrantCandidateSet(int K)
                         (int) From->Y + 3.0 * (From->Y -
                                                (int) From->Y) / 5.0;
             } while ((From = From->Suc) != FirstNode);
+            ComputeTrigTerms();
             Level++;
             CreateQuadrantCandidateSet(K);
             Level--;
             From = FirstNode;
             do
-                From->Y = From->Zc;
+                From->Y = Zc(From);
             while ((From = From->Suc) != FirstNode);
+            ComputeTrigTerms();
             do {
                 Candidate *QCandidateSet = From->CandidateSet;
                 From->CandidateSet = SavedCandidateSet[From->Id];
@@ -149,8 +146,8 @@ void CreateQuadrantCandidateSet(int K)
                     AddCandidate(From, To, NFrom->Cost, NFrom->Alpha);
                 free(QCandidateSet);
             } while ((From = From->Suc) != FirstNode);
-            free(SavedCandidateSet);
         }
+        ReleaseArena(&ScratchArena, Mark);
     }
     if (Level == 0) {
         ResetCandidateSet();
@@ -173,30 +170,31 @@ void CreateNearestNeighborCandidateSet(int K)
 {
     Node *From, *To;
     int i;
+    ArenaMark Mark = MarkArena(&ScratchArena);
 
     if (TraceLevel >= 2)
         printff("Creating nearest neighbor candidate set ... ");
     KDTree = BuildKDTree(1);
-    assert(XMin =
-           (double *) malloc((1 + DimensionSaved) * sizeof(double)));
-    assert(XMax =
-           (double *) malloc((1 + DimensionSaved) * sizeof(double)));
-    assert(YMin =
-           (double *) malloc((1 + DimensionSaved) * sizeof(double)));
-    assert(YMax =
-           (double *) malloc((1 + DimensionSaved) * sizeof(double)));
+    XMin = (double *)
+        ArenaAlloc(&ScratchArena, (1 + DimensionSaved) * sizeof(double));
+    XMax = (double *)
+        ArenaAlloc(&ScratchArena, (1 + DimensionSaved) * sizeof(double));
+    YMin = (double *)
+        ArenaAlloc(&ScratchArena, (1 + DimensionSaved) * sizeof(double));
+    YMax = (double *)
+        ArenaAlloc(&ScratchArena, (1 + DimensionSaved) * sizeof(double));
     if (CoordType == THREED_COORDS) {
-        assert(ZMin =
-               (double *) malloc((1 + DimensionSaved) * sizeof(double)));
-        assert(ZMax =
-               (double *) malloc((1 + DimensionSaved) * sizeof(double)));
+        ZMin = (double *)
+            ArenaAlloc(&ScratchArena, (1 + DimensionSaved) * sizeof(double));
+        ZMax = (double *)
+            ArenaAlloc(&ScratchArena, (1 + DimensionSaved) * sizeof(double));
     }
     ComputeBounds(0, Dimension - 1);
     Contains = CoordType == THREED_COORDS ? Contains3D : Contains2D;
     BoxOverlaps =
         CoordType == THREED_COORDS ? BoxOverlaps3D : BoxOverlaps2D;
-    assert(CandidateSet =
-           (Candidate *) malloc((K + 1) * sizeof(Candidate)));
+    CandidateSet = (Candidate *)
+        ArenaAlloc(&ScratchArena, (K + 1) * sizeof(Candidate));
 
     From = FirstNode;
     do {
@@ -207,21 +205,12 @@ void CreateNearestNeighborCandidateSet(int K)
         }
     } while ((From = From->Suc) != FirstNode);
 
-    free(CandidateSet);
-    free(KDTree);
-    free(XMin);
-    free(XMax);
-    free(YMin);
-    free(YMax);
-    if (CoordType == THREED_COORDS) {
-        free(ZMin);
-        free(ZMax);
-    }
+    ReleaseArena(&ScratchArena, Mark);
     if (Level == 0 && (WeightType == GEOM || WeightType == GEOM_MEEUS)) {
         Candidate **SavedCandidateSet;
-        assert(SavedCandidateSet =
-               (Candidate **) malloc((1 + DimensionSaved) *
-                                     sizeof(Candidate *)));
+        SavedCandidateSet = (Candidate **)
+            ArenaAlloc(&ScratchArena,
+                       (1 + DimensionSaved) * sizeof(Candidate *));
         if (TraceLevel >= 2)
             printff("done\n");
         /* Transform longitude (180 and -180 map to 0) */
@@ -229,16 +218,18 @@ void CreateNearestNeighborCandidateSet(int K)
         do {
             SavedCandidateSet[From->Id] = From->CandidateSet;
             From->CandidateSet = 0;
-            From->Yc = From->Y;
+            Yc(From) = From->Y;
             From->Y += From->Y > 0 ? -180 : 180;
         } while ((From = From->Suc) != FirstNode);
+        ComputeTrigTerms();
         Level++;
         CreateNearestNeighborCandidateSet(K);
         Level--;
         From = FirstNode;
         do
-            From->Y = From->Yc;
+            From->Y = Yc(From);
         while ((From = From->Suc) != FirstNode);
+        ComputeTrigTerms();
         do {
             Candidate *QCandidateSet = From->CandidateSet;
             Candidate *NFrom;
@@ -247,7 +238,7 @@ void CreateNearestNeighborCandidateSet(int K)
                 AddCandidate(From, To, NFrom->Cost, NFrom->Alpha);
             free(QCandidateSet);
         } while ((From = From->Suc) != FirstNode);
-        free(SavedCandidateSet);
+        ReleaseArena(&ScratchArena, Mark);
     }
     if (Level == 0) {
         ResetCandidateSet();
@@ -74,7 +74,7 @@ void delaunay(int n)
         N = N->Suc;
     }
 
-    assert(p_sorted = (point **) malloc(n * sizeof(point *)));
+    p_sorted = (point **) ArenaAlloc(&ScratchArena, n * sizeof(point *));
     for (i = 0; i < n; i++)
         p_sorted[i] = p_array + i;
     qsort(p_sorted, n, sizeof(point *), compare);
@@ -94,7 +94,6 @@ void delaunay(int n)
     }
 
     divide(p_sorted, 0, n - 1, &l_cw, &r_ccw);
-    free(p_sorted);
 }
 
 static void divide(point * p_sorted[], int l, int r,
@@ -462,25 +461,34 @@ point *p_array;
 static edge *e_array;
 static edge **free_list_e;
 static int n_free_e;
+static ArenaMark mark;
+
+/* 
+ * The points and edges are allocated from ScratchArena and are released
+ * by free_memory.
+ */
 
 static void alloc_memory(int n)
 {
     edge *e;
     int i;
 
-    assert(p_array = (point *) calloc(n, sizeof(point)));
+    mark = MarkArena(&ScratchArena);
+    p_array = (point *) ArenaCalloc(&ScratchArena, n, sizeof(point));
     n_free_e = 3 * n;
-    assert(e_array = e = (edge *) calloc(n_free_e, sizeof(edge)));
-    assert(free_list_e = (edge **) calloc(n_free_e, sizeof(edge *)));
+    e_array = e = (edge *) ArenaCalloc(&ScratchArena, n_free_e, sizeof(edge));
+    free_list_e =
+        (edge **) ArenaCalloc(&ScratchArena, n_free_e, sizeof(edge *));
     for (i = 0; i < n_free_e; i++, e++)
         free_list_e[i] = e;
 }
 
 void free_memory()
 {
-    free(p_array);
-    free(e_array);
-    free(free_list_e);
+    ReleaseArena(&ScratchArena, mark);
+    p_array = 0;
+    e_array = 0;
+    free_list_e = 0;
 }
 
 static edge *get_edge()
@@ -45,6 +45,36 @@ int Distance_EUC_2D(Node * Na, Node * Nb)
     return (int) (sqrt(xd * xd + yd * yd) + 0.5);
 }
 
+/*
+ * The Distance_EUC_2D_FLOAT function is used instead of Distance_EUC_2D if
+ * EUC_2D_SINGLE_PRECISION = YES and all coordinates are integers less than
+ * 2^20 in absolute value (see ReadProblem). For two such nodes the squared
+ * distance s is an exact integer less than 2^43, and the distance is
+ * rounded from the single-precision square root of s. The result n is
+ * accepted only if it is provably the rounded distance, that is, if
+ * (2n - 1)^2 <= 4s < (2n + 1)^2 in integer arithmetic. Otherwise, for
+ * example when the distance is close to n + 0.5, the distance is computed
+ * in double precision, as it is if s is not such an integer (e.g., for the
+ * non-integer centers of SolveKMeansSubproblems). The result is therefore
+ * always equal to that of Distance_EUC_2D.
+ */
+
+int Distance_EUC_2D_FLOAT(Node * Na, Node * Nb)
+{
+    double xd = Na->X - Nb->X, yd = Na->Y - Nb->Y, s = xd * xd + yd * yd;
+    int n;
+    long long s4, m;
+
+    if (s != floor(s) || s >= 8796093022208.0)
+        return (int) (sqrt(s) + 0.5);
+    n = (int) (sqrtf((float) s) + 0.5f);
+    s4 = 4 * (long long) s;
+    m = 2 * (long long) n;
+    if ((m - 1) * (m - 1) <= s4 && s4 < (m + 1) * (m + 1))
+        return n;
+    return (int) (sqrt(s) + 0.5);
+}
+
 int Distance_EUC_3D(Node * Na, Node * Nb)
 {
     double xd = Na->X - Nb->X, yd = Na->Y - Nb->Y, zd = Na->Z - Nb->Z;
@@ -56,31 +86,50 @@ int Distance_EXPLICIT(Node * Na, Node * Nb)
     return Na->Id < Nb->Id ? Nb->C[Na->Id] : Na->C[Nb->Id];
 }
 
+int Distance_EXPLICIT_8(Node * Na, Node * Nb)
+{
+    return CostMatrixOffset + CostMatrix8[CostIndex(Na->Id, Nb->Id)];
+}
+
+int Distance_EXPLICIT_16(Node * Na, Node * Nb)
+{
+    return CostMatrixOffset + CostMatrix16[CostIndex(Na->Id, Nb->Id)];
+}
+
 #define PI 3.141592
 #define RRR 6378.388
 
+/*
+ * The distance functions for geographical coordinates use the terms
+ * computed by ComputeTrigTerms. The cosines (and sines) of sums and 
+ * differences of angles are computed by the addition formulas.
+ *
+ * The Terms function returns the terms of a node. The terms of a node that
+ * does not belong to NodeSet (Id zero) are computed in a given record.
+ */
+
+static TrigTerms *Terms(Node * N, TrigTerms * T)
+{
+    if (N->Id == 0) {
+        NodeTrigTerms(N, T);
+        return T;
+    }
+    return &Trig[N->Id];
+}
+
 int Distance_GEO(Node * Na, Node * Nb)
 {
-    int deg;
-    double NaLatitude, NaLongitude, NbLatitude, NbLongitude, min, q1, q2,
-        q3;
-    deg = (int) Na->X;
-    min = Na->X - deg;
-    NaLatitude = PI * (deg + 5.0 * min / 3.0) / 180.0;
-    deg = (int) Na->Y;
-    min = Na->Y - deg;
-    NaLongitude = PI * (deg + 5.0 * min / 3.0) / 180.0;
-    deg = (int) Nb->X;
-    min = Nb->X - deg;
-    NbLatitude = PI * (deg + 5.0 * min / 3.0) / 180.0;
-    deg = (int) Nb->Y;
-    min = Nb->Y - deg;
-    NbLongitude = PI * (deg + 5.0 * min / 3.0) / 180.0;
-    q1 = cos(NaLongitude - NbLongitude);
-    q2 = cos(NaLatitude - NbLatitude);
-    q3 = cos(NaLatitude + NbLatitude);
-    return (int) (RRR * acos(0.5 * ((1.0 + q1) * q2 - (1.0 - q1) * q3)) +
-                  1.0);
+    TrigTerms Ta, Tb, *a = Terms(Na, &Ta), *b = Terms(Nb, &Tb);
+    double q1 = a->CosLon * b->CosLon + a->SinLon * b->SinLon,
+        q2 = a->CosLat * b->CosLat + a->SinLat * b->SinLat,
+        q3 = a->CosLat * b->CosLat - a->SinLat * b->SinLat,
+        q = 0.5 * ((1.0 + q1) * q2 - (1.0 - q1) * q3);
+    /* Rounding may move q slightly outside the domain of acos */
+    if (q > 1.0)
+        q = 1.0;
+    else if (q < -1.0)
+        q = -1.0;
+    return (int) (RRR * acos(q) + 1.0);
 }
 
 #undef M_PI
@@ -89,15 +138,17 @@ int Distance_GEO(Node * Na, Node * Nb)
 
 int Distance_GEOM(Node * Na, Node * Nb)
 {
-    double lati = M_PI * (Na->X / 180.0);
-    double latj = M_PI * (Nb->X / 180.0);
-    double longi = M_PI * (Na->Y / 180.0);
-    double longj = M_PI * (Nb->Y / 180.0);
-    double q1 = cos(latj) * sin(longi - longj);
-    double q3 = sin((longi - longj) / 2.0);
-    double q4 = cos((longi - longj) / 2.0);
-    double q2 = sin(lati + latj) * q3 * q3 - sin(lati - latj) * q4 * q4;
-    double q5 = cos(lati - latj) * q4 * q4 - cos(lati + latj) * q3 * q3;
+    TrigTerms Ta, Tb, *a = Terms(Na, &Ta), *b = Terms(Nb, &Tb);
+    double q1 =
+        b->CosLat * (a->SinLon * b->CosLon - a->CosLon * b->SinLon);
+    double q3 = a->SinHalfLon * b->CosHalfLon - a->CosHalfLon * b->SinHalfLon;
+    double q4 = a->CosHalfLon * b->CosHalfLon + a->SinHalfLon * b->SinHalfLon;
+    double SinSum = a->SinLat * b->CosLat + a->CosLat * b->SinLat;
+    double SinDiff = a->SinLat * b->CosLat - a->CosLat * b->SinLat;
+    double CosSum = a->CosLat * b->CosLat - a->SinLat * b->SinLat;
+    double CosDiff = a->CosLat * b->CosLat + a->SinLat * b->SinLat;
+    double q2 = SinSum * q3 * q3 - SinDiff * q4 * q4;
+    double q5 = CosDiff * q4 * q4 - CosSum * q3 * q3;
     return (int) (M_RRR * atan2(sqrt(q1 * q1 + q2 * q2), q5) + 1.0);
 }
 
@@ -136,20 +187,19 @@ int Distance_MAX_3D(Node * Na, Node * Nb)
        "Astronomical Algorithms (2nd Ed.)", pg. 85, Jean Meeus (2000).
 */
 
-static double Meeus(double lat1, double lon1, double lat2, double lon2)
+static double Meeus(TrigTerms * a, TrigTerms * b)
 {
-    const double a = 6378.137;  /* equator earth radius */
+    const double A = 6378.137;  /* equator earth radius */
     const double fl = 1 / 298.257;      /* earth flattening */
-    double f, g, l, sg, sl, sf, s, c, w, r, d, h1, h2;
+    double sg, sl, sf, s, c, w, r, d, h1, h2;
 
-    if (lat1 == lat2 && lon1 == lon2)
+    if (a->Lat == b->Lat && a->Lon == b->Lon)
         return 0;
-    f = (lat1 + lat2) / 2;
-    g = (lat1 - lat2) / 2;
-    l = (lon1 - lon2) / 2;
-    sg = sin(g);
-    sl = sin(l);
-    sf = sin(f);
+    /* The sines of f = (lat1 + lat2) / 2, g = (lat1 - lat2) / 2, and 
+       l = (lon1 - lon2) / 2 */
+    sf = a->SinHalfLat * b->CosHalfLat + a->CosHalfLat * b->SinHalfLat;
+    sg = a->SinHalfLat * b->CosHalfLat - a->CosHalfLat * b->SinHalfLat;
+    sl = a->SinHalfLon * b->CosHalfLon - a->CosHalfLon * b->SinHalfLon;
     sg = sg * sg;
     sl = sl * sl;
     sf = sf * sf;
@@ -157,7 +207,7 @@ static double Meeus(double lat1, double lon1, double lat2, double lon2)
     c = (1 - sg) * (1 - sl) + sf * sl;
     w = atan(sqrt(s / c));
     r = sqrt(s * c) / w;
-    d = 2 * w * a;
+    d = 2 * w * A;
     h1 = (3 * r - 1) / 2 / c;
     h2 = (3 * r + 1) / 2 / s;
     return d * (1 + fl * (h1 * sf * (1 - sg) - h2 * (1 - sf) * sg));
@@ -165,24 +215,14 @@ static double Meeus(double lat1, double lon1, double lat2, double lon2)
 
 int Distance_GEO_MEEUS(Node * Na, Node * Nb)
 {
-    double lat1 =
-        M_PI * ((int) Na->X + 5 * (Na->X - (int) Na->X) / 3) / 180;
-    double lon1 =
-        M_PI * ((int) Na->Y + 5 * (Na->Y - (int) Na->Y) / 3) / 180;
-    double lat2 =
-        M_PI * ((int) Nb->X + 5 * (Nb->X - (int) Nb->X) / 3) / 180;
-    double lon2 =
-        M_PI * ((int) Nb->Y + 5 * (Nb->Y - (int) Nb->Y) / 3) / 180;
-    return (int) (Meeus(lat1, lon1, lat2, lon2) + 0.5);
+    TrigTerms Ta, Tb;
+    return (int) (Meeus(Terms(Na, &Ta), Terms(Nb, &Tb)) + 0.5);
 }
 
 int Distance_GEOM_MEEUS(Node * Na, Node * Nb)
 {
-    double lat1 = M_PI * (Na->X / 180);
-    double lon1 = M_PI * (Na->Y / 180);
-    double lat2 = M_PI * (Nb->X / 180);
-    double lon2 = M_PI * (Nb->Y / 180);
-    return (int) (1000 * Meeus(lat1, lon1, lat2, lon2) + 0.5);
+    TrigTerms Ta, Tb;
+    return (int) (1000 * Meeus(Terms(Na, &Ta), Terms(Nb, &Tb)) + 0.5);
 }
 
 #undef min
@@ -0,0 +1,285 @@
+#include "LKH.h"
+
+/*
+ * The DistanceBatch function computes the distances from node Na to each of
+ * the Count nodes Nb[0], Nb[1], ..., Nb[Count - 1], and stores them in
+ * D[0], D[1], ..., D[Count - 1]. On return, D[i] == Distance(Na, Nb[i]).
+ *
+ * For the distance functions of the edge weight types EUC_2D, EUC_3D,
+ * CEIL_2D, CEIL_3D, MAN_2D, MAN_3D, MAX_2D, MAX_3D and ATT, the distances
+ * are computed by SIMD kernels that handle 8 (AVX-512) or 4 (AVX2) nodes at
+ * a time. The kernel is chosen at run time from the features of the
+ * processor. The kernels perform the same IEEE operations in the same order
+ * as the scalar functions in Distance.c (no fused multiply-adds), and
+ * truncate and round up in the same way, so the results are identical.
+ *
+ * For distances computed by a DISTANCE_LIBRARY, the library is called once
+ * for the whole batch (see DistanceLibrary.c). For all other distance
+ * functions, on other processors, and if the scalar functions may have
+ * been compiled with fused multiply-adds (__FMA__), Distance is called for
+ * each node.
+ *
+ * The DistanceBatchXYZ function does the same for targets given by the
+ * contiguous coordinate arrays X, Y and Z (Z may be 0 for 2D types). It
+ * may only be called if BatchableDistance() returns 1.
+ */
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && \
+    !defined(__FMA__)
+#define DISTANCE_KERNELS
+#include <immintrin.h>
+
+static void DistanceBatch_AVX2(int Type, Node * Na, Node ** Nb,
+                               const double *X, const double *Y,
+                               const double *Z, int Count, int *D);
+static void DistanceBatch_AVX512(int Type, Node * Na, Node ** Nb,
+                                 const double *X, const double *Y,
+                                 const double *Z, int Count, int *D);
+#endif
+
+static int KernelType(void);
+static int Kernels(Node * Na, Node ** Nb, const double *X,
+                   const double *Y, const double *Z, int Count, int *D);
+
+void DistanceBatch(Node * Na, Node ** Nb, int Count, int *D)
+{
+    int i;
+
+    if (Distance == Distance_LIBRARY) {
+        DistanceLibraryBatch(Na, Nb, Count, D);
+        return;
+    }
+    i = Kernels(Na, Nb, 0, 0, 0, Count, D);
+
+    for (; i < Count; i++)
+        D[i] = Distance(Na, Nb[i]);
+}
+
+void DistanceBatchXYZ(Node * Na, const double *X, const double *Y,
+                      const double *Z, int Count, int *D)
+{
+    int i = Kernels(Na, 0, X, Y, Z, Count, D);
+    Node Nb;
+
+    for (; i < Count; i++) {
+        Nb.X = X[i];
+        Nb.Y = Y[i];
+        Nb.Z = Z ? Z[i] : 0;
+        D[i] = Distance(Na, &Nb);
+    }
+}
+
+/*
+ * The BatchableDistance function returns 1 if the current distance function
+ * only depends on the coordinates of the nodes and is handled by the
+ * kernels; otherwise 0.
+ */
+
+int BatchableDistance()
+{
+    return KernelType() != EXPLICIT;
+}
+
+/*
+ * The Kernels function computes as many of the distances as possible with
+ * the SIMD kernels, and returns the number of distances computed.
+ */
+
+static int Kernels(Node * Na, Node ** Nb, const double *X,
+                   const double *Y, const double *Z, int Count, int *D)
+{
+#ifdef DISTANCE_KERNELS
+    static int Level = -1;      /* 0: none, 1: AVX2, 2: AVX-512 */
+    int Type;
+
+    if (Level < 0) {
+        __builtin_cpu_init();
+        Level = __builtin_cpu_supports("avx512f") ? 2 :
+            __builtin_cpu_supports("avx2") ? 1 : 0;
+    }
+    if (Level > 0 && Count >= 4 && (Type = KernelType()) != EXPLICIT) {
+        if (Level == 2)
+            DistanceBatch_AVX512(Type, Na, Nb, X, Y, Z, Count, D);
+        else
+            DistanceBatch_AVX2(Type, Na, Nb, X, Y, Z, Count, D);
+        return Count - Count % (Level == 2 ? 8 : 4);
+    }
+#endif
+    return 0;
+}
+
+/*
+ * The KernelType function returns the edge weight type of the current
+ * distance function, or EXPLICIT if there is no kernel for it.
+ */
+
+static int KernelType()
+{
+    return Distance == Distance_EUC_2D ? EUC_2D :
+        Distance == Distance_EUC_2D_FLOAT ? EUC_2D :
+        Distance == Distance_EUC_3D ? EUC_3D :
+        Distance == Distance_CEIL_2D ? CEIL_2D :
+        Distance == Distance_CEIL_3D ? CEIL_3D :
+        Distance == Distance_MAN_2D ? MAN_2D :
+        Distance == Distance_MAN_3D ? MAN_3D :
+        Distance == Distance_MAX_2D ? MAX_2D :
+        Distance == Distance_MAX_3D ? MAX_3D :
+        Distance == Distance_ATT ? ATT : EXPLICIT;
+}
+
+#ifdef DISTANCE_KERNELS
+
+/*
+ * AVX-512 implies FMA, so floating-point contraction is turned off to keep
+ * the multiplications and additions separate.
+ */
+
+#ifdef __clang__
+#define KERNEL(ISA) __attribute__ ((target(ISA)))
+#else
+#define KERNEL(ISA)\
+    __attribute__ ((target(ISA), optimize("fp-contract=off")))
+#endif
+
+#define Is3D(Type)\
+    ((Type) == EUC_3D || (Type) == CEIL_3D || (Type) == MAN_3D ||\
+     (Type) == MAX_3D)
+
+/*
+ * The kernels below compute the distances for the first
+ * Count - Count % 4 (AVX2) or Count - Count % 8 (AVX-512) nodes. The
+ * coordinates are gathered from the nodes Nb, or, if Nb is 0, loaded from
+ * the arrays X, Y and Z.
+ */
+
+KERNEL("avx2")
+static void DistanceBatch_AVX2(int Type, Node * Na, Node ** Nb,
+                               const double *X, const double *Y,
+                               const double *Z, int Count, int *D)
+{
+    const __m256d Xa = _mm256_set1_pd(Na->X), Ya = _mm256_set1_pd(Na->Y),
+        Za = _mm256_set1_pd(Na->Z), Half = _mm256_set1_pd(0.5),
+        Ten = _mm256_set1_pd(10.0), Sign = _mm256_set1_pd(-0.0);
+    __m256d xd, yd, zd = _mm256_setzero_pd(), s;
+    __m128i d;
+    int i;
+
+#define Ceil(x) _mm256_round_pd(x, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC)
+#define Abs(x) _mm256_andnot_pd(Sign, x)
+#define Round(x) _mm256_cvttpd_epi32(_mm256_add_pd(x, Half))
+#define Load(F)\
+    (Nb ? _mm256_set_pd(Nb[i + 3]->F, Nb[i + 2]->F, Nb[i + 1]->F,\
+                        Nb[i]->F) : _mm256_loadu_pd(F + i))
+    for (i = 0; i + 4 <= Count; i += 4) {
+        xd = _mm256_sub_pd(Xa, Load(X));
+        yd = _mm256_sub_pd(Ya, Load(Y));
+        if (Is3D(Type))
+            zd = _mm256_sub_pd(Za, Load(Z));
+        s = _mm256_add_pd(_mm256_mul_pd(xd, xd), _mm256_mul_pd(yd, yd));
+        if (Is3D(Type))
+            s = _mm256_add_pd(s, _mm256_mul_pd(zd, zd));
+        switch (Type) {
+        case EUC_2D:
+        case EUC_3D:
+            d = Round(_mm256_sqrt_pd(s));
+            break;
+        case CEIL_2D:
+        case CEIL_3D:
+            d = _mm256_cvttpd_epi32(Ceil(_mm256_sqrt_pd(s)));
+            break;
+        case ATT:
+            d = _mm256_cvttpd_epi32(Ceil
+                                    (_mm256_sqrt_pd
+                                     (_mm256_div_pd(s, Ten))));
+            break;
+        case MAN_2D:
+            d = Round(_mm256_add_pd(Abs(xd), Abs(yd)));
+            break;
+        case MAN_3D:
+            d = Round(_mm256_add_pd(_mm256_add_pd(Abs(xd), Abs(yd)),
+                                    Abs(zd)));
+            break;
+        case MAX_2D:
+            d = _mm_max_epi32(Round(Abs(xd)), Round(Abs(yd)));
+            break;
+        default:               /* MAX_3D */
+            d = _mm_max_epi32(_mm_max_epi32(Round(Abs(xd)),
+                                            Round(Abs(yd))),
+                              Round(Abs(zd)));
+            break;
+        }
+        _mm_storeu_si128((__m128i *) (D + i), d);
+    }
+#undef Ceil
+#undef Abs
+#undef Round
+#undef Load
+}
+
+KERNEL("avx512f")
+static void DistanceBatch_AVX512(int Type, Node * Na, Node ** Nb,
+                                 const double *X, const double *Y,
+                                 const double *Z, int Count, int *D)
+{
+    const __m512d Xa = _mm512_set1_pd(Na->X), Ya = _mm512_set1_pd(Na->Y),
+        Za = _mm512_set1_pd(Na->Z), Half = _mm512_set1_pd(0.5),
+        Ten = _mm512_set1_pd(10.0);
+    __m512d xd, yd, zd = _mm512_setzero_pd(), s;
+    __m256i d;
+    int i;
+
+#define Ceil(x)\
+    _mm512_roundscale_pd(x, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC)
+#define Abs(x) _mm512_abs_pd(x)
+#define Round(x) _mm512_cvttpd_epi32(_mm512_add_pd(x, Half))
+#define Load(F)\
+    (Nb ? _mm512_set_pd(Nb[i + 7]->F, Nb[i + 6]->F, Nb[i + 5]->F,\
+                        Nb[i + 4]->F, Nb[i + 3]->F, Nb[i + 2]->F,\
+                        Nb[i + 1]->F, Nb[i]->F) : _mm512_loadu_pd(F + i))
+    for (i = 0; i + 8 <= Count; i += 8) {
+        xd = _mm512_sub_pd(Xa, Load(X));
+        yd = _mm512_sub_pd(Ya, Load(Y));
+        if (Is3D(Type))
+            zd = _mm512_sub_pd(Za, Load(Z));
+        s = _mm512_add_pd(_mm512_mul_pd(xd, xd), _mm512_mul_pd(yd, yd));
+        if (Is3D(Type))
+            s = _mm512_add_pd(s, _mm512_mul_pd(zd, zd));
+        switch (Type) {
+        case EUC_2D:
+        case EUC_3D:
+            d = Round(_mm512_sqrt_pd(s));
+            break;
+        case CEIL_2D:
+        case CEIL_3D:
+            d = _mm512_cvttpd_epi32(Ceil(_mm512_sqrt_pd(s)));
+            break;
+        case ATT:
+            d = _mm512_cvttpd_epi32(Ceil
+                                    (_mm512_sqrt_pd
+                                     (_mm512_div_pd(s, Ten))));
+            break;
+        case MAN_2D:
+            d = Round(_mm512_add_pd(Abs(xd), Abs(yd)));
+            break;
+        case MAN_3D:
+            d = Round(_mm512_add_pd(_mm512_add_pd(Abs(xd), Abs(yd)),
+                                    Abs(zd)));
+            break;
+        case MAX_2D:
+            d = _mm256_max_epi32(Round(Abs(xd)), Round(Abs(yd)));
+            break;
+        default:               /* MAX_3D */
+            d = _mm256_max_epi32(_mm256_max_epi32(Round(Abs(xd)),
+                                                  Round(Abs(yd))),
+                                 Round(Abs(zd)));
+            break;
+        }
+        _mm256_storeu_si256((__m256i *) (D + i), d);
+    }
+#undef Ceil
+#undef Abs
+#undef Round
+#undef Load
+}
+
+#endif
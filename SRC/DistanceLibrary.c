@@ -0,0 +1,219 @@
+#include "LKH.h"
+#include <dlfcn.h>
+
+/*
+ * The functions in this file implement distances of the edge weight type
+ * SPECIAL that are computed by a shared library (DISTANCE_LIBRARY). The
+ * library is loaded with dlopen and must export the function
+ *
+ *     void LKH_DistanceBatch(int From, int Count, const int *To, int *D);
+ *
+ * which stores the distances from node From to the nodes To[0], To[1], ...,
+ * To[Count - 1] in D[0], D[1], ..., D[Count - 1]. Nodes are identified by
+ * their numbers in the problem file. The library may also export
+ *
+ *     int LKH_DistanceInit(int Dimension, const double *X, const double *Y,
+ *                          const double *Z);
+ *
+ * which is called once before any distance is requested. The coordinates
+ * of node i are X[i], Y[i] and Z[i]. The arrays are 0 if the problem has no
+ * coordinates, and they are only valid during the call. A nonzero return
+ * value aborts the program.
+ *
+ * Each distance obtained from the library is kept in a hash table (the
+ * memo), so that the library is never asked twice for the same pair. The
+ * memo is consulted after the tour, the candidate sets and the distance
+ * cache (see C_FUNCTION). It is not used while a cost matrix exists, since
+ * the matrix holds every distance. The number of distances kept may be
+ * limited by DISTANCE_LIBRARY_MEMO_SIZE; when the limit is reached, new
+ * distances are computed but not kept. The memo is freed, and the library
+ * unloaded, by FreeDistanceLibrary (called from FreeStructures).
+ */
+
+typedef void (*BatchFunction) (int From, int Count, const int *To,
+                               int *D);
+typedef int (*InitFunction) (int Dimension, const double *X,
+                             const double *Y, const double *Z);
+
+static void *Handle;            /* The loaded library */
+static BatchFunction Batch;
+static unsigned long long *MemoKey;     /* Packed node numbers, 0 if empty */
+static int *MemoVal;            /* Memoized distances */
+static size_t MemoMask;         /* Number of slots - 1 */
+static size_t MemoUsed;         /* Number of distances kept */
+
+static int Lookup(Node * Na, Node * Nb, size_t * Slot);
+static void Store(size_t Slot, Node * Na, Node * Nb, int d);
+
+#define Memoized() (!CostMatrix && !CostMatrix8 && !CostMatrix16)
+
+/*
+ * The LoadDistanceLibrary function loads the library and makes Distance
+ * refer to Distance_LIBRARY. It is called by ReadProblem after the nodes
+ * have been read (and renumbered).
+ */
+
+void LoadDistanceLibrary()
+{
+    InitFunction Init;
+    double *X = 0, *Y = 0, *Z = 0;
+    int i;
+
+    FreeDistanceLibrary();
+    if (!(Handle = dlopen(DistanceLibraryName, RTLD_NOW | RTLD_LOCAL)))
+        eprintf("DISTANCE_LIBRARY: %s", dlerror());
+    if (!(*(void **) &Batch = dlsym(Handle, "LKH_DistanceBatch")))
+        eprintf("DISTANCE_LIBRARY: LKH_DistanceBatch not found in \"%s\"",
+                DistanceLibraryName);
+    if ((*(void **) &Init = dlsym(Handle, "LKH_DistanceInit"))) {
+        if (CoordType != NO_COORDS) {
+            assert(X = (double *) calloc(Dimension + 1, sizeof(double)));
+            assert(Y = (double *) calloc(Dimension + 1, sizeof(double)));
+            assert(Z = (double *) calloc(Dimension + 1, sizeof(double)));
+            for (i = 1; i <= Dimension; i++) {
+                X[ExternalId(i)] = NodeSet[i].X;
+                Y[ExternalId(i)] = NodeSet[i].Y;
+                Z[ExternalId(i)] = NodeSet[i].Z;
+            }
+        }
+        if (Init(Dimension, X, Y, Z))
+            eprintf("DISTANCE_LIBRARY: LKH_DistanceInit failed");
+        free(X);
+        free(Y);
+        free(Z);
+    }
+    Distance = Distance_LIBRARY;
+}
+
+/*
+ * The FreeDistanceLibrary function frees the memo and unloads the library
+ * (if any).
+ */
+
+void FreeDistanceLibrary()
+{
+    LargeFree(MemoKey);
+    LargeFree(MemoVal);
+    MemoKey = 0;
+    MemoVal = 0;
+    MemoMask = MemoUsed = 0;
+    if (Handle)
+        dlclose(Handle);
+    Handle = 0;
+    Batch = 0;
+}
+
+int Distance_LIBRARY(Node * Na, Node * Nb)
+{
+    size_t Slot = 0;
+    int From, To, d;
+
+    if (Memoized() && (d = Lookup(Na, Nb, &Slot)) >= 0)
+        return d;
+    From = ExternalId(Na->Id);
+    To = ExternalId(Nb->Id);
+    Batch(From, 1, &To, &d);
+    if (Memoized())
+        Store(Slot, Na, Nb, d);
+    return d;
+}
+
+/*
+ * The DistanceLibraryBatch function is called by DistanceBatch. The
+ * distances that are not in the memo are requested from the library in
+ * one call.
+ */
+
+void DistanceLibraryBatch(Node * Na, Node ** Nb, int Count, int *D)
+{
+    int *To, *Index, *Missing, Misses = 0, i, d;
+    size_t Slot = 0;
+    ArenaMark Mark = MarkArena(&ScratchArena);
+
+    To = (int *) ArenaAlloc(&ScratchArena, Count * sizeof(int));
+    Index = (int *) ArenaAlloc(&ScratchArena, Count * sizeof(int));
+    Missing = (int *) ArenaAlloc(&ScratchArena, Count * sizeof(int));
+    for (i = 0; i < Count; i++) {
+        if (Memoized() && (d = Lookup(Na, Nb[i], &Slot)) >= 0)
+            D[i] = d;
+        else {
+            To[Misses] = ExternalId(Nb[i]->Id);
+            Index[Misses++] = i;
+        }
+    }
+    if (Misses > 0) {
+        Batch(ExternalId(Na->Id), Misses, To, Missing);
+        for (i = 0; i < Misses; i++) {
+            D[Index[i]] = Missing[i];
+            if (Memoized() && Lookup(Na, Nb[Index[i]], &Slot) < 0)
+                Store(Slot, Na, Nb[Index[i]], Missing[i]);
+        }
+    }
+    ReleaseArena(&ScratchArena, Mark);
+}
+
+#define Key(Na, Nb)\
+    ((Na)->Id < (Nb)->Id ?\
+     (unsigned long long) (Na)->Id << 32 | (unsigned) (Nb)->Id :\
+     (unsigned long long) (Nb)->Id << 32 | (unsigned) (Na)->Id)
+#define Hash(K) ((size_t) (((K) * 0x9E3779B97F4A7C15ULL) >> 20))
+
+/*
+ * The Lookup function returns the memoized distance between Na and Nb, or
+ * -1 if it is not in the memo. In the latter case, *Slot is set to the
+ * slot where the distance can be stored.
+ */
+
+static int Lookup(Node * Na, Node * Nb, size_t * Slot)
+{
+    unsigned long long K = Key(Na, Nb);
+    size_t i;
+
+    if (!MemoKey)
+        return -1;
+    for (i = Hash(K) & MemoMask; MemoKey[i]; i = (i + 1) & MemoMask)
+        if (MemoKey[i] == K)
+            return MemoVal[i];
+    *Slot = i;
+    return -1;
+}
+
+/*
+ * The Store function stores the distance d between Na and Nb in the memo.
+ * The memo is doubled when it becomes half full (as long as the limit on
+ * the number of distances allows it).
+ */
+
+static void Store(size_t Slot, Node * Na, Node * Nb, int d)
+{
+    unsigned long long *OldKey = MemoKey, K;
+    int *OldVal = MemoVal;
+    size_t OldSize = MemoKey ? MemoMask + 1 : 0, Size, i, j;
+
+    if (d < 0 || (DistanceLibraryMemoSize > 0 &&
+                  MemoUsed >= (size_t) DistanceLibraryMemoSize))
+        return;
+    if (2 * (MemoUsed + 1) > OldSize) {
+        Size = OldSize ? 2 * OldSize : 1024;
+        MemoKey = (unsigned long long *)
+            LargeCalloc(Size, sizeof(unsigned long long));
+        MemoVal = (int *) LargeCalloc(Size, sizeof(int));
+        MemoMask = Size - 1;
+        for (i = 0; i < OldSize; i++) {
+            if (!(K = OldKey[i]))
+                continue;
+            for (j = Hash(K) & MemoMask; MemoKey[j];
+                 j = (j + 1) & MemoMask);
+            MemoKey[j] = K;
+            MemoVal[j] = OldVal[i];
+        }
+        LargeFree(OldKey);
+        LargeFree(OldVal);
+        K = Key(Na, Nb);
+        for (Slot = Hash(K) & MemoMask; MemoKey[Slot];
+             Slot = (Slot + 1) & MemoMask);
+    }
+    MemoKey[Slot] = Key(Na, Nb);
+    MemoVal[Slot] = d;
+    MemoUsed++;
+}
@@ -13,6 +13,12 @@
  * edges that are common to two currently best tours. The candidate set is
  * extended with those tour edges that are not present in the current set.
  * The original candidate set is re-established at exit from FindTour.
+ *
+ * If CHECKPOINT_TRIALS is positive, a checkpoint is written after every
+ * CHECKPOINT_TRIALS trials (see Checkpoint.c). If the run is resumed from
+ * such a checkpoint (ResumeTrial > 0), the state of the run has been
+ * restored by ReadCheckpoint, and FindTour continues with the trial
+ * following trial ResumeTrial.
  */
 
 /*
@@ -33,15 +39,10 @@ GainType FindTour()
     GainType Cost;
     Node *t;
     int i;
-    double EntryTime = GetTime();
+    double EntryTime = GetTime() - ResumeTime;
 
-    t = FirstNode;
-    //初始化所有节点的OldPred，OldSuc，NextBestSuc和BestSuc 为 0;
-    do
-        t->OldPred = t->OldSuc = t->NextBestSuc = t->BestSuc = 0;
-    while ((t = t->Suc) != FirstNode);
     // 这个if语句只会在FindTour()函数第一次运行时进入
-    if (Run == 1 && Dimension == DimensionSaved) {
+    if ((Run == 1 || OrdinalTourCost == 0) && Dimension == DimensionSaved) {
         // 初始化OrdinalTourCost
         OrdinalTourCost = 0;
         for (i = 1; i < Dimension; i++)
@@ -51,17 +52,26 @@ GainType FindTour()
                            - NodeSet[Dimension].Pi - NodeSet[1].Pi;
         OrdinalTourCost /= Precision;
     }
-    BetterCost = PLUS_INFINITY;
-    if (MaxTrials > 0)
-        // HashInitialize(HTable)会把传入的HTable清空
-        HashInitialize(HTable);
-    // 这个else语句永远不会进入
-    else {
-        Trial = 1;
-        ChooseInitialTour();
+    /* A resumed run continues with the tours and HTable of the checkpoint */
+    if (!ResumeTrial) {
+        t = FirstNode;
+        //初始化所有节点的OldPred，OldSuc，NextBestSuc和BestSuc 为 0;
+        do
+            t->OldPred = t->OldSuc = t->NextBestSuc = t->BestSuc = 0;
+        while ((t = t->Suc) != FirstNode);
+        BetterCost = PLUS_INFINITY;
+        if (MaxTrials > 0)
+            // HashInitialize(HTable)会把传入的HTable清空
+            HashInitialize(HTable);
+        // 这个else语句永远不会进入
+        else {
+            Trial = 1;
+            ChooseInitialTour();
+        }
     }
     //运行MaxTrials(节点个数)次LKH算法
-    for (Trial = 1; Trial <= MaxTrials; Trial++) {
+    for (Trial = ResumeTrial + 1, ResumeTrial = 0, ResumeTime = 0;
+         Trial <= MaxTrials; Trial++) {
         // 当程序运行时间即将超过规定时间时，终止for循环
         if (GetTime() - EntryTime >= TimeLimit) {
             if (TraceLevel >= 1)
@@ -79,6 +89,9 @@ GainType FindTour()
         ChooseInitialTour();
         // LinKernighan()函数通过opt交换来修正可行解。这个函数会返回修正解权重        
         Cost = LinKernighan();
+        if (FlipSampling &&
+            (Trial >= SegmentTuningTrials || Trial == MaxTrials))
+            TuneSegments();
         if (FirstNode->BestSuc) {
             //将当前最优路径合并
             t = FirstNode;
@@ -132,18 +145,22 @@ GainType FindTour()
             } else
                 SwapCandidateSets();
         }
+        if (CheckpointTrials > 0 && Trial % CheckpointTrials == 0 &&
+            Trial < MaxTrials && !FlipSampling && !BackboneCandidateTable)
+            WriteCheckpoint(1, GetTime() - EntryTime);
     }
     //不会进入
-    if (BackboneTrials > 0 && BackboneTrials < MaxTrials) {
+    if (BackboneCandidateTable) {
         if (Trial > BackboneTrials ||
                 (Trial == BackboneTrials &&
                  (!StopAtOptimum || BetterCost != Optimum)))
             SwapCandidateSets();
         t = FirstNode;
-        do {
-            free(t->BackboneCandidateSet);
-            t->BackboneCandidateSet = 0;
-        } while ((t = t->Suc) != FirstNode);
+        do
+            free(BackboneCandidateSet(t));
+        while ((t = t->Suc) != FirstNode);
+        LargeFree(BackboneCandidateTable);
+        BackboneCandidateTable = 0;
     }
     t = FirstNode;
     //这个if无意义
@@ -171,9 +188,12 @@ static void SwapCandidateSets()
 {
     printf("我被运行\n");
     Node *t = FirstNode;
+    if (!BackboneCandidateTable)
+        BackboneCandidateTable =
+            (Candidate **) AllocateNodeTable(sizeof(Candidate *));
     do {
         Candidate *Temp = t->CandidateSet;
-        t->CandidateSet = t->BackboneCandidateSet;
-        t->BackboneCandidateSet = Temp;
+        t->CandidateSet = BackboneCandidateSet(t);
+        BackboneCandidateSet(t) = Temp;
     } while ((t = t->Suc) != FirstNode);
 }
@@ -0,0 +1,94 @@
+#include "LKH.h"
+
+/*
+ * The Flip_A function performs a 2-opt move. Edges (t1,t2) and (t3,t4)
+ * are exchanged with edges (t2,t3) and (t4,t1). Node t4 is one of
+ * t3's two neighbors on the tour; which one is uniquely determined
+ * by the orientation of (t1,t2).
+ *
+ * The function is only used if the array representation is used for
+ * a tour. In this representation the tour is kept in the array TourArray,
+ * and the Rank of each node is its position in the array. As in the
+ * doubly linked list representation, Pred and Suc of each node reference
+ * its neighbors, and the function Between is used for determining whether
+ * a node is between two other nodes.
+ *
+ * The 2-opt move is made by reversing the shorter of the two segments
+ * defined by the move. The segment is reversed by swapping the nodes at its
+ * two ends in TourArray, working inwards. In contrast to the Flip function,
+ * which follows the Suc pointers from node to node, the nodes to be visited
+ * are found by consecutive array accesses.
+ *
+ * The move is pushed onto a stack of 2-opt moves. The stack makes it
+ * possible to undo moves (by the RestoreTour function).
+ *
+ * Finally, the hash value corresponding to the tour is updated.
+ */
+
+#define Reverse(s)\
+    { Node *u = (s)->Suc; (s)->Suc = (s)->Pred; (s)->Pred = u;\
+      Temp = (s)->SucCost; (s)->SucCost = (s)->PredCost;\
+      (s)->PredCost = Temp; }
+
+void Flip_A(Node * t1, Node * t2, Node * t3)
+{
+    Node *s1, *s2, *t4;
+    int i, j, R, Temp, Ct2t3, Ct4t1;
+
+    assert(t1->Pred == t2 || t1->Suc == t2);
+    if (t3 == t2->Pred || t3 == t2->Suc)
+        return;
+    t4 = t1->Suc == t2 ? t3->Pred : t3->Suc;
+    if (t1->Suc != t2) {
+        s1 = t1;
+        t1 = t2;
+        t2 = s1;
+        s1 = t3;
+        t3 = t4;
+        t4 = s1;
+    }
+    /* Find the segment with the smallest number of nodes */
+    if ((R = t2->Rank - t3->Rank) < 0)
+        R += Dimension;
+    if (2 * R > Dimension) {
+        s1 = t3;
+        t3 = t2;
+        t2 = s1;
+        s1 = t4;
+        t4 = t1;
+        t1 = s1;
+        if ((R = t2->Rank - t3->Rank) < 0)
+            R += Dimension;
+    }
+    Ct2t3 = C(t2, t3);
+    Ct4t1 = C(t4, t1);
+    /* Reverse segment (t3 --> t1), which contains R nodes */
+    i = t3->Rank;
+    j = t1->Rank;
+    for (R /= 2; R > 0; R--) {
+        s1 = TourArray[i];
+        s2 = TourArray[j];
+        (TourArray[i] = s2)->Rank = i;
+        (TourArray[j] = s1)->Rank = j;
+        Reverse(s1);
+        Reverse(s2);
+        if (++i > Dimension)
+            i = 1;
+        if (--j == 0)
+            j = Dimension;
+    }
+    if (i == j)
+        Reverse(TourArray[i]);
+    (t3->Suc = t2)->Pred = t3;
+    (t4->Suc = t1)->Pred = t4;
+    t3->SucCost = t2->PredCost = Ct2t3;
+    t1->PredCost = t4->SucCost = Ct4t1;
+    SwapStack[Swaps].t1 = t1;
+    SwapStack[Swaps].t2 = t2;
+    SwapStack[Swaps].t3 = t3;
+    SwapStack[Swaps].t4 = t4;
+    Swaps++;
+    Hash ^= (Rand[t1->Id] * Rand[t2->Id]) ^
+        (Rand[t3->Id] * Rand[t4->Id]) ^
+        (Rand[t2->Id] * Rand[t3->Id]) ^ (Rand[t4->Id] * Rand[t1->Id]);
+}
@@ -0,0 +1,181 @@
+#include "LKH.h"
+
+/*
+ * The Flip_BT function performs a 2-opt move. Edges (t1,t2) and (t3,t4) 
+ * are exchanged with edges (t2,t3) and (t4,t1). Node t4 is one of 
+ * t3's two neighbors on the tour; which one is uniquely determined
+ * by the orientation of (t1,t2).
+ *
+ * The function is only used if the balanced tree representation is used 
+ * for a tour (see BTree.c). 
+ *
+ * The 2-opt move is made by reversing the one of the two segments defined
+ * by the move that does not wrap around the ends of the sequence 
+ * represented by the tree. The tree is split into three trees, the 
+ * segment, the part before, and the part after the segment. Then the 
+ * reversal bit of the segment's tree is switched, and the three trees are
+ * merged. The expected time cost of a 2-opt move is O(log n).
+ *
+ * The Pred and Suc pointers of the four nodes t1, t2, t3 and t4 are 
+ * updated as in the Flip_SL function.
+ *
+ * When a 2-opt move has been made it is pushed onto a stack of 2-opt moves.
+ * The stack makes it possible to undo moves (by the RestoreTour function).
+ *
+ * Finally, the hash value corresponding to the tour is updated.
+ */
+
+static void Push(int t);
+static void Split(int t, int k, int *l, int *r);
+static int Merge(int l, int r);
+
+void Flip_BT(Node * t1, Node * t2, Node * t3)
+{
+    Node *t4, *b, *d;
+    int i, j, L, M, R, Ct2t3, Ct4t1;
+
+    assert(t1->Pred == t2 || t1->Suc == t2);
+    if (t3 == t2->Pred || t3 == t2->Suc)
+        return;
+    /* Let b and d be the first and last node of a segment whose reversal
+       makes the move, in the sequence represented by the tree */
+    if (t2 == (Flipped_BT(t1) ? t1->Pred : t1->Suc)) {
+        t4 = Flipped_BT(t3) ? t3->Suc : t3->Pred;
+        b = t2;
+        d = t4;
+    } else {
+        t4 = Flipped_BT(t3) ? t3->Pred : t3->Suc;
+        b = t1;
+        d = t3;
+    }
+    i = Position_BT(b);
+    j = Position_BT(d);
+    if (i > j) {
+        /* Reverse the complementary segment instead */
+        L = i;
+        i = j + 1;
+        j = L - 1;
+    }
+    Ct2t3 = C(t2, t3);
+    Ct4t1 = C(t4, t1);
+    /* Reverse the nodes at positions i, i + 1, ..., j */
+    Split(BTreeRoot, i, &L, &M);
+    Split(M, j - i + 1, &M, &R);
+    BTree[M].Reversed ^= 1;
+    BTreeRoot = Merge(Merge(L, M), R);
+    BTree[BTreeRoot].Parent = 0;
+    BTreeStamp++;
+    if (t3->Suc == t4) {
+        t3->Suc = t2;
+        t3->SucCost = Ct2t3;
+    } else {
+        t3->Pred = t2;
+        t3->PredCost = Ct2t3;
+    }
+    if (t2->Suc == t1) {
+        t2->Suc = t3;
+        t2->SucCost = Ct2t3;
+    } else {
+        t2->Pred = t3;
+        t2->PredCost = Ct2t3;
+    }
+    if (t1->Pred == t2) {
+        t1->Pred = t4;
+        t1->PredCost = Ct4t1;
+    } else {
+        t1->Suc = t4;
+        t1->SucCost = Ct4t1;
+    }
+    if (t4->Pred == t3) {
+        t4->Pred = t1;
+        t4->PredCost = Ct4t1;
+    } else {
+        t4->Suc = t1;
+        t4->SucCost = Ct4t1;
+    }
+    SwapStack[Swaps].t1 = t1;
+    SwapStack[Swaps].t2 = t2;
+    SwapStack[Swaps].t3 = t3;
+    SwapStack[Swaps].t4 = t4;
+    Swaps++;
+    Hash ^= (Rand[t1->Id] * Rand[t2->Id]) ^
+        (Rand[t3->Id] * Rand[t4->Id]) ^
+        (Rand[t2->Id] * Rand[t3->Id]) ^ (Rand[t4->Id] * Rand[t1->Id]);
+}
+
+/*
+ * The Push function propagates the reversal bit of tree node t to its
+ * children.
+ */
+
+static void Push(int t)
+{
+    BTNode *T = &BTree[t];
+    int u;
+
+    if (T->Reversed) {
+        u = T->Left;
+        T->Left = T->Right;
+        T->Right = u;
+        BTree[T->Left].Reversed ^= 1;
+        BTree[T->Right].Reversed ^= 1;
+        T->Flipped ^= 1;
+        T->Reversed = 0;
+    }
+}
+
+/*
+ * The Split function splits the tree with root t into two trees, l and r,
+ * where l contains the first k nodes of the sequence, and r contains 
+ * the remaining nodes.
+ */
+
+static void Split(int t, int k, int *l, int *r)
+{
+    BTNode *T = &BTree[t];
+    int Size;
+
+    if (!t) {
+        *l = *r = 0;
+        return;
+    }
+    Push(t);
+    if ((Size = BTree[T->Left].Size) >= k) {
+        Split(T->Left, k, l, &T->Left);
+        BTree[T->Left].Parent = t;
+        *r = t;
+    } else {
+        Split(T->Right, k - Size - 1, &T->Right, r);
+        BTree[T->Right].Parent = t;
+        *l = t;
+    }
+    T->Size = BTree[T->Left].Size + BTree[T->Right].Size + 1;
+}
+
+/*
+ * The Merge function merges the trees l and r, where all nodes of l
+ * precede all nodes of r in the sequence, and returns the root of the
+ * resulting tree.
+ */
+
+static int Merge(int l, int r)
+{
+    BTNode *T;
+
+    if (!l || !r)
+        return l ? l : r;
+    if (Rand[l] > Rand[r]) {
+        Push(l);
+        T = &BTree[l];
+        T->Right = Merge(T->Right, r);
+        BTree[T->Right].Parent = l;
+    } else {
+        Push(r);
+        T = &BTree[r];
+        T->Left = Merge(l, T->Left);
+        BTree[T->Left].Parent = r;
+        l = r;
+    }
+    T->Size = BTree[T->Left].Size + BTree[T->Right].Size + 1;
+    return l;
+}
@@ -39,8 +39,6 @@
 
 static void SplitSegment(Node * t1, Node * t2);
 
-#define SPLIT_CUTOFF 0.75
-
 void Flip_SL(Node * t1, Node * t2, Node * t3)
 {
     Node *t4, *a, *b, *c, *d;
@@ -55,7 +53,9 @@ void Flip_SL(Node * t1, Node * t2, Node * t3)
         Flip(t1, t2, t3);
         return;
     }
-    t4 = t2 == SUC(t1) ? PRED(t3) : SUC(t3);
+    if (FlipSampling)
+        SampleFlip(SegmentSize_SL(t2, t3));
+    t4 = t2 == SUC_SL(t1) ? PRED_SL(t3) : SUC_SL(t3);
     P1 = t1->Parent;
     P2 = t2->Parent;
     P3 = t3->Parent;
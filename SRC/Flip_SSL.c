@@ -25,8 +25,6 @@ static void FlipSegments(Segment * a, Segment * b,
 static void FlipSSegments(SSegment * a, SSegment * b,
                           SSegment * c, SSegment * d);
 
-#define SPLIT_CUTOFF 0.75
-
 void Flip_SSL(Node * t1, Node * t2, Node * t3)
 {
     Node *t4, *a, *b, *c, *d;
@@ -39,7 +37,9 @@ void Flip_SSL(Node * t1, Node * t2, Node * t3)
         Flip(t1, t2, t3);
         return;
     }
-    t4 = t2 == SUC(t1) ? PRED(t3) : SUC(t3);
+    if (FlipSampling)
+        SampleFlip(SegmentSize_SSL(t2, t3));
+    t4 = t2 == SUC_SSL(t1) ? PRED_SSL(t3) : SUC_SSL(t3);
     P1 = t1->Parent;
     P2 = t2->Parent;
     P3 = t3->Parent;
@@ -7,28 +7,37 @@
  */
 
 #define Free(s) { free(s); s = 0; }
+#define FreeLarge(s) { LargeFree(s); s = 0; }
 
 void FreeStructures()
 {
     FreeCandidateSets();
+    FreeLarge(BackboneCandidateTable);
     FreeSegments();
     if (NodeSet) {
         int i;
         for (i = 1; i <= Dimension; i++) {
             Node *N = &NodeSet[i];
-            Free(N->MergeSuc);
             N->C = 0;
         }
-        Free(NodeSet);
+        FreeLarge(NodeSet);
     }
-    Free(CostMatrix);
-    Free(BestTour);
-    Free(BetterTour);
+    FreeCostMatrix();
+    FreeDistanceLibrary();
+    FreeLarge(BestTour);
+    FreeLarge(BetterTour);
     Free(SwapStack);
     Free(HTable);
-    Free(Rand);
-    Free(CacheSig);
-    Free(CacheVal);
+    FreeLarge(Rand);
+    FreeLarge(DistanceCache);
+    FreeLarge(Trig);
+    FreeLarge(InitialSucTable);
+    FreeLarge(InputSucTable);
+    FreeLarge(MergeSucTable);
+    FreeLarge(SubproblemLinkTable);
+    FreeLarge(ConvertedCoordTable);
+    FreeLarge(ExternalIdTable);
+    FreeLarge(InternalIdTable);
     Free(Name);
     Free(Type);
     Free(EdgeWeightType);
@@ -46,32 +55,33 @@ void FreeStructures()
     Free(cycle);
     Free(G);
     FreePopulation();
+    FreeArena(&ScratchArena);
+    FreeArena(&SegmentArena);
 }
 
 /*      
-   The FreeSegments function frees the segments.
+   The FreeSegments function frees the segments (and the array of the
+   array representation, or the tree nodes of the balanced tree 
+   representation).
  */
 
 void FreeSegments()
 {
-    if (FirstSegment) {
-        Segment *S = FirstSegment, *SPrev;
-        do {
-            SPrev = S->Pred;
-            Free(S);
-        }
-        while ((S = SPrev) != FirstSegment);
-        FirstSegment = 0;
-    }
-    if (FirstSSegment) {
-        SSegment *SS = FirstSSegment, *SSPrev;
-        do {
-            SSPrev = SS->Pred;
-            Free(SS);
-        }
-        while ((SS = SSPrev) != FirstSSegment);
-        FirstSSegment = 0;
-    }
+    FreeSegmentLists();
+    Free(TourArray);
+    Free(BTree);
+}
+
+/*      
+   The FreeSegmentLists function frees the segments and super segments
+   of the two-level and three-level tree representations.
+ */
+
+void FreeSegmentLists()
+{
+    ResetArena(&SegmentArena);
+    FirstSegment = 0;
+    FirstSSegment = 0;
 }
 
 /*      
@@ -85,7 +95,8 @@ void FreeCandidateSets()
         return;
     do {
         Free(N->CandidateSet);
-        Free(N->BackboneCandidateSet);
+        if (BackboneCandidateTable)
+            Free(BackboneCandidateSet(N));
     }
     while ((N = N->Suc) != FirstNode);
 }
@@ -12,24 +12,22 @@
 
 GainType Gain23()
 {
-    static  Node *s1 = 0;
-    static short OldReversed = 0;
-    Node *s2, *s3, *s4, *s5, *s6 = 0, *s7, *s8 = 0, *s1Stop;
+    Node *s1, *s2, *s3, *s4, *s5, *s6 = 0, *s7, *s8 = 0, *s1Stop;
     Candidate *Ns2, *Ns4, *Ns6;
     GainType G0, G1, G2, G3, G4, G5, G6, Gain, Gain6;
     int X2, X4, X6, X8, Case6 = 0, Case8 = 0;
     int Breadth2, Breadth4, Breadth6;
 
-    if (!s1 || s1->Subproblem != FirstNode->Subproblem)
-        s1 = FirstNode;
-    s1Stop = s1;
+    if (!Gain23Node || Gain23Node->Subproblem != FirstNode->Subproblem)
+        Gain23Node = FirstNode;
+    s1Stop = s1 = Gain23Node;
     for (X2 = 1; X2 <= 2; X2++) {
-        Reversed = X2 == 1 ? OldReversed : (OldReversed ^= 1);
+        Reversed = X2 == 1 ? Gain23Reversed : (Gain23Reversed ^= 1);
         do {
             s2 = SUC(s1);
             if (FixedOrCommon(s1, s2))
                 continue;
-            G0 = C(s1, s2);
+            G0 = TOUR_COST(s1, s2);
             Breadth2 = 0;
             /* Choose (s2,s3) as a candidate edge emanating from s2 */
             for (Ns2 = s2->CandidateSet; (s3 = Ns2->To); Ns2++) {
@@ -42,7 +40,7 @@ GainType Gain23()
                     s4 = X4 == 1 ? SUC(s3) : PRED(s3);
                     if (FixedOrCommon(s3, s4))
                         continue;
-                    G2 = G1 + C(s3, s4);
+                    G2 = G1 + TOUR_COST(s3, s4);
                     /* Try any gainful nonfeasible 2-opt move 
                        followed by a 2-, 3- or 4-opt move */
                     if (X4 == 1 && s4 != s1 && !Forbidden(s4, s1) &&
@@ -97,7 +95,7 @@ GainType Gain23()
                             }
                             if (FixedOrCommon(s5, s6))
                                 continue;
-                            G4 = G3 + C(s5, s6);
+                            G4 = G3 + TOUR_COST(s5, s6);
                             Gain6 = 0;
                             if (!Forbidden(s6, s1) &&
                                 (!c || G4 - c(s6, s1) > 0) &&
@@ -196,7 +194,7 @@ GainType Gain23()
                                     if (FixedOrCommon(s7, s8)
                                         || Forbidden(s8, s1))
                                         continue;
-                                    G6 = G5 + C(s7, s8);
+                                    G6 = G5 + TOUR_COST(s7, s8);
                                     if ((!c || G6 - c(s8, s1) > 0) &&
                                         (Gain = G6 - C(s8, s1)) > 0) {
                                         if (Case8 <= 15) {
@@ -219,7 +217,7 @@ GainType Gain23()
                 }
             }
         }
-        while ((s1 = s2) != s1Stop);
+        while ((Gain23Node = s1 = s2) != s1Stop);
     }
     return 0;
 }
@@ -1,6 +1,30 @@
 #include "LKH.h"
 #include "Genetic.h"
 
+/*
+ * Each individual is stored as an array of int. The nodes of the problem
+ * (or subproblem) are numbered 1 to Dimension in the order they have in 
+ * the tour when the population is created (IndividualNode[k] is node number
+ * k, and NodeIndex[N->Id] is the number of node N). For an individual P,
+ * P[k] is the number of the successor of node number k.
+ *
+ * The array is followed by a signature of the edge set of the individual:
+ * each edge is hashed into one of SIGNATURE_SIZE buckets, and the 
+ * signature counts the edges in each bucket. Since all individuals have
+ * Dimension edges, the signatures of two individuals give a lower bound 
+ * on the number of edges in which they differ (see DistanceToIndividual).
+ */
+
+#define SIGNATURE_SIZE 64
+#define Bucket(a, b) ((Rand[a] * Rand[b]) >> 26)
+
+static Node **IndividualNode;
+static int *NodeIndex;
+static int *Tour;
+
+static void CreatePopulation(void);
+static void StoreIndividual(int *P);
+
 /*
  * The AddToPopulation function adds the current tour as an individual to 
  * the population. The fitness of the individual is set equal to the cost
@@ -10,17 +34,9 @@
 void AddToPopulation(GainType Cost)
 {
     int i, *P;
-    Node *N;
 
-    if (!Population) {
-        assert(Population =
-               (int **) malloc(MaxPopulationSize * sizeof(int *)));
-        for (i = 0; i < MaxPopulationSize; i++)
-            assert(Population[i] =
-                   (int *) malloc((1 + Dimension) * sizeof(int)));
-        assert(Fitness =
-               (GainType *) malloc(MaxPopulationSize * sizeof(GainType)));
-    }
+    if (!Population)
+        CreatePopulation();
     for (i = PopulationSize; i >= 1 && Cost < Fitness[i - 1]; i--) {
         Fitness[i] = Fitness[i - 1];
         P = Population[i];
@@ -28,14 +44,43 @@ void AddToPopulation(GainType Cost)
         Population[i - 1] = P;
     }
     Fitness[i] = Cost;
-    P = Population[i];
+    StoreIndividual(Population[i]);
+    PopulationSize++;
+}
+
+/*
+ * The CreatePopulation function allocates the population, and numbers the
+ * nodes in the order they have in the current tour.
+ */
+
+static void CreatePopulation()
+{
+    int i, Size = 1 + Dimension + SIGNATURE_SIZE, MaxId = 0;
+    Node *N;
+
+    Population = (int **)
+        ArenaAlloc(&ScratchArena, MaxPopulationSize * sizeof(int *));
+    for (i = 0; i < MaxPopulationSize; i++)
+        Population[i] = (int *)
+            ArenaAlloc(&ScratchArena, Size * sizeof(int));
+    Fitness = (GainType *)
+        ArenaAlloc(&ScratchArena, MaxPopulationSize * sizeof(GainType));
+    Tour = (int *) ArenaAlloc(&ScratchArena, Size * sizeof(int));
+    IndividualNode = (Node **)
+        ArenaAlloc(&ScratchArena, (1 + Dimension) * sizeof(Node *));
     N = FirstNode;
-    i = 1;
     do
-        P[i++] = N->Id;
+        if (N->Id > MaxId)
+            MaxId = N->Id;
+    while ((N = N->Suc) != FirstNode);
+    NodeIndex = (int *)
+        ArenaAlloc(&ScratchArena, (1 + MaxId) * sizeof(int));
+    i = 0;
+    do {
+        IndividualNode[++i] = N;
+        NodeIndex[N->Id] = i;
+    }
     while ((N = N->Suc) != FirstNode);
-    P[0] = P[Dimension];
-    PopulationSize++;
 }
 
 /*
@@ -50,8 +95,8 @@ void ApplyCrossover(int i, int j)
     Pi = Population[i];
     Pj = Population[j];
     for (k = 1; k <= Dimension; k++) {
-        NodeSet[Pi[k - 1]].Suc = &NodeSet[Pi[k]];
-        NodeSet[Pj[k - 1]].Next = &NodeSet[Pj[k]];
+        IndividualNode[k]->Suc = IndividualNode[Pi[k]];
+        IndividualNode[k]->Next = IndividualNode[Pj[k]];
     }
     if (TraceLevel >= 1)
         printff("Crossover(%d,%d)\n", i + 1, j + 1);
@@ -59,22 +104,22 @@ void ApplyCrossover(int i, int j)
     Crossover();
 }
 
-#define Free(s) { free(s); s = 0; }
-
 /*
  * The FreePopulation function frees the memory space allocated to the 
  * population.
+ *
+ * The population is allocated from ScratchArena. When the population
+ * belongs to a subproblem, its space is released by SolveSubproblem;
+ * otherwise, when the problem is freed.
  */
 
 void FreePopulation()
 {
-    if (Population) {
-        int i;
-        for (i = 0; i < MaxPopulationSize; i++)
-            Free(Population[i]);
-        Free(Population);
-        Free(Fitness);
-    }
+    Population = 0;
+    Fitness = 0;
+    Tour = 0;
+    IndividualNode = 0;
+    NodeIndex = 0;
     PopulationSize = 0;
 }
 
@@ -144,7 +189,7 @@ GainType MergeTourWithIndividual(int i)
     assert(i >= 0 && i < PopulationSize);
     Pi = Population[i];
     for (k = 1; k <= Dimension; k++)
-        NodeSet[Pi[k - 1]].Next = &NodeSet[Pi[k]];
+        IndividualNode[k]->Next = IndividualNode[Pi[k]];
     return MergeWithTour();
 }
 
@@ -166,6 +211,37 @@ void PrintPopulation()
     }
 }
 
+/*
+ * The ReadPopulation function reads a population written by WritePopulation
+ * (see WriteCheckpoint). It returns 1 if the population could be read;
+ * otherwise 0.
+ */
+
+int ReadPopulation(FILE * f)
+{
+    int i, Id, Size = 1 + Dimension + SIGNATURE_SIZE;
+
+    if (!ReadInputBytes(f, &PopulationSize, sizeof(int)) ||
+        PopulationSize < 0 || PopulationSize > MaxPopulationSize)
+        return 0;
+    if (PopulationSize == 0)
+        return 1;
+    if (!Population)
+        CreatePopulation();
+    for (i = 1; i <= Dimension; i++) {
+        if (!ReadInputBytes(f, &Id, sizeof(int)) || Id < 1 || Id > Dimension)
+            return 0;
+        IndividualNode[i] = &NodeSet[Id];
+        NodeIndex[Id] = i;
+    }
+    if (!ReadInputBytes(f, Fitness, PopulationSize * sizeof(GainType)))
+        return 0;
+    for (i = 0; i < PopulationSize; i++)
+        if (!ReadInputBytes(f, Population[i], Size * sizeof(int)))
+            return 0;
+    return 1;
+}
+
 /*
  * The ReplaceIndividualWithTour function replaces a given individual in 
  * the population by an indidual that represents the current tour.
@@ -174,18 +250,12 @@ void PrintPopulation()
 
 void ReplaceIndividualWithTour(int i, GainType Cost)
 {
-    int j, *P;
-    Node *N;
+    int *P;
 
     assert(i >= 0 && i < PopulationSize);
     Fitness[i] = Cost;
     P = Population[i];
-    N = FirstNode;
-    for (j = 1; j <= Dimension; j++) {
-        P[j] = N->Id;
-        N = N->Suc;
-    }
-    P[0] = P[Dimension];
+    StoreIndividual(P);
     while (i >= 1 && Cost < Fitness[i - 1]) {
         Fitness[i] = Fitness[i - 1];
         Population[i] = Population[i - 1];
@@ -202,24 +272,71 @@ void ReplaceIndividualWithTour(int i, GainType Cost)
     Population[i] = P;
 }
 
+/*
+ * The WritePopulation function writes the population to a file: its size,
+ * the numbering of the nodes, the fitness values, and the individuals.
+ */
+
+void WritePopulation(FILE * f)
+{
+    int i, Size = 1 + Dimension + SIGNATURE_SIZE;
+
+    fwrite(&PopulationSize, sizeof(int), 1, f);
+    if (PopulationSize == 0)
+        return;
+    for (i = 1; i <= Dimension; i++)
+        fwrite(&IndividualNode[i]->Id, sizeof(int), 1, f);
+    fwrite(Fitness, sizeof(GainType), PopulationSize, f);
+    for (i = 0; i < PopulationSize; i++)
+        fwrite(Population[i], sizeof(int), Size, f);
+}
+
+/*
+ * The StoreIndividual function stores the current tour, and the signature
+ * of its edges, in a given array.
+ */
+
+static void StoreIndividual(int *P)
+{
+    int *Signature = P + 1 + Dimension;
+    Node *N = FirstNode;
+
+    memset(Signature, 0, SIGNATURE_SIZE * sizeof(int));
+    do {
+        P[NodeIndex[N->Id]] = NodeIndex[N->Suc->Id];
+        Signature[Bucket(N->Id, N->Suc->Id)]++;
+    }
+    while ((N = N->Suc) != FirstNode);
+}
+
 /* 
- * The DistanceToIndividual returns the number of different edges between 
- * the tour (given by OldSuc) and individual i. 
+ * The DistanceToIndividual returns the number of edges of the tour T 
+ * (stored as an individual) that are not edges of individual i. 
+ *
+ * The computation is stopped as soon as the number is known to be at least
+ * Limit, in which case a number greater than or equal to Limit is 
+ * returned. Each bucket of the signature of T that contains more edges
+ * than the same bucket of the signature of individual i contains at least
+ * that many edges that are not edges of individual i. If the sum of these
+ * differences is at least Limit, the edges need not be compared.
  */
 
-static int DistanceToIndividual(int i) { 
-    int Count = 0, j, *P = Population[i];
-    Node *N;
-    
-    for (j = 0; j < Dimension; j++) {
-        N = &NodeSet[P[j]];
-        (N->Next = &NodeSet[P[j + 1]])->Prev = N;
+static int DistanceToIndividual(int *T, int i, int Limit)
+{
+    int Count = 0, a, b, *P = Population[i];
+    int *TS = T + 1 + Dimension, *PS = P + 1 + Dimension;
+
+    for (a = 0; a < SIGNATURE_SIZE; a++)
+        if (TS[a] > PS[a])
+            Count += TS[a] - PS[a];
+    if (Count >= Limit)
+        return Count;
+    Count = 0;
+    for (a = 1; a <= Dimension; a++) {
+        b = T[a];
+        if (P[a] != b && P[b] != a && ++Count >= Limit)
+            break;
     }
-    N = FirstNode;
-    do
-        if (N->OldSuc != N->Next && N->OldSuc != N->Prev)
-            Count++;
-    while ((N = N->OldSuc) != FirstNode);
     return Count;
 }
 
@@ -235,23 +352,20 @@ static int DistanceToIndividual(int i) {
  */
 
 int ReplacementIndividual(GainType Cost) {
-    int i, j, d, *P;
+    int i, d;
     int MinDist = INT_MAX, CMin = PopulationSize - 1;
-    Node *N = FirstNode;
-    while ((N = N->OldSuc = N->Suc) != FirstNode);
+    StoreIndividual(Tour);
     for (i = PopulationSize - 1; i >= 0 && Fitness[i] > Cost; i--) {
-        if ((d = DistanceToIndividual(i)) < MinDist) {
+        if ((d = DistanceToIndividual(Tour, i, MinDist)) < MinDist) {
             CMin = i;
             MinDist = d;
         }
     }
     if (CMin == PopulationSize - 1)
         return CMin;
-    P = Population[CMin];
-    for (j = 0; j < Dimension; j++)
-        NodeSet[P[j]].OldSuc = &NodeSet[P[j + 1]];
     for (i = 0; i < PopulationSize; i++)
-        if (i != CMin && (d = DistanceToIndividual(i)) <= MinDist)
+        if (i != CMin &&
+            DistanceToIndividual(Population[CMin], i, MinDist + 1) <= MinDist)
             return PopulationSize - 1;
     return CMin;
 }
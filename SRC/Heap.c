@@ -2,16 +2,45 @@
 #include "Heap.h"
 
 /*
- * A binary heap is used to implement a priority queue. 
+ * A d-ary heap is used to implement a priority queue. 
  *
  * A heap is useful in order to speed up the computations of minimum 
  * spanning trees. The elements of the heap are the nodes, and the
  * priorities (ranks) are their associated costs (their minimum distance 
  * to the current tree). 
+ *
+ * The arity of the heap, HEAP_ARITY, may be chosen at compile time
+ * (e.g., -DHEAP_ARITY=2 gives a binary heap). The default is a 4-ary heap,
+ * which has half the height of a binary heap. The root is stored at 
+ * location HEAP_ARITY - 1 of the array Heap, and the children of the node 
+ * at location Loc are stored at the locations 
+ * HEAP_ARITY * (Loc - HEAP_ARITY + 2), ..., 
+ * HEAP_ARITY * (Loc - HEAP_ARITY + 2) + HEAP_ARITY - 1.
+ * The location 0 signifies that a node is not in the heap.
+ *
+ * The rank of each node in the heap is copied into the array HeapRank, 
+ * so that the ranks of the children of a node can be compared without 
+ * accessing the nodes themselves. If HEAP_ARITY is a power of two 
+ * (at most 16), the children of a node start at a location that is a 
+ * multiple of HEAP_ARITY, and, since the array is aligned at a cache line 
+ * boundary, their ranks share a single cache line.
+ *
+ * The rank of a node must not be changed while the node is in the heap, 
+ * unless it is decreased and followed by a call of HeapSiftUp.
  */
 
+#ifndef HEAP_ARITY
+#define HEAP_ARITY 4
+#endif
+
+#define HEAP_ROOT (HEAP_ARITY - 1)
+#define HeapParent(Loc) ((Loc) / HEAP_ARITY + HEAP_ARITY - 2)
+#define HeapFirstChild(Loc) (HEAP_ARITY * ((Loc) - HEAP_ARITY + 2))
+
 static int HeapCount;    /* Its current number of elements */
 static int HeapCapacity; /* Its capacity */
+static int HeapLast;     /* The location of its last element */
+static int *HeapRank;    /* The ranks of its elements */
 
 /*      
  * The MakeHeap function creates an empty heap. 
@@ -19,9 +48,15 @@ static int HeapCapacity; /* Its capacity */
 
 void MakeHeap(int Size)
 {
-    assert(Heap = (Node **) malloc((Size + 1) * sizeof(Node *)));
+    /* Heap and HeapRank are allocated as one block (freed by Free(Heap)) */
+    size_t Locs = (Size + HEAP_ROOT + 15) / 16 * 16;
+
+    assert(posix_memalign((void **) &Heap, 64,
+                          Locs * (sizeof(Node *) + sizeof(int))) == 0);
+    HeapRank = (int *) (Heap + Locs);
     HeapCapacity = Size;
     HeapCount = 0;
+    HeapLast = HEAP_ROOT - 1;
 }
 
 /*
@@ -34,14 +69,15 @@ void MakeHeap(int Size)
 
 void HeapSiftUp(Node * N)
 {
-    int Loc = N->Loc, Parent = Loc / 2;
+    int Loc = N->Loc, Parent = HeapParent(Loc), Rank = N->Rank;
 
-    while (Parent && N->Rank < Heap[Parent]->Rank) {
-        Heap[Loc] = Heap[Parent];
-        Heap[Loc]->Loc = Loc;
+    while (Loc > HEAP_ROOT && Rank < HeapRank[Parent]) {
+        HeapRank[Loc] = HeapRank[Parent];
+        (Heap[Loc] = Heap[Parent])->Loc = Loc;
         Loc = Parent;
-        Parent /= 2;
+        Parent = HeapParent(Loc);
     }
+    HeapRank[Loc] = Rank;
     Heap[Loc] = N;
     N->Loc = Loc;
 }
@@ -55,18 +91,22 @@ void HeapSiftUp(Node * N)
 
 void HeapSiftDown(Node * N)
 {
-    int Loc = N->Loc, Child;
-
-    while (Loc <= HeapCount / 2) {
-        Child = 2 * Loc;
-        if (Child < HeapCount && Heap[Child + 1]->Rank < Heap[Child]->Rank)
-            Child++;
-        if (N->Rank <= Heap[Child]->Rank)
+    int Loc = N->Loc, Child, First, Last, Rank = N->Rank;
+
+    while ((First = HeapFirstChild(Loc)) <= HeapLast) {
+        Child = First;
+        if ((Last = First + HEAP_ARITY - 1) > HeapLast)
+            Last = HeapLast;
+        while (++First <= Last)
+            if (HeapRank[First] < HeapRank[Child])
+                Child = First;
+        if (Rank <= HeapRank[Child])
             break;
-        Heap[Loc] = Heap[Child];
-        Heap[Loc]->Loc = Loc;
+        HeapRank[Loc] = HeapRank[Child];
+        (Heap[Loc] = Heap[Child])->Loc = Loc;
         Loc = Child;
     }
+    HeapRank[Loc] = Rank;
     Heap[Loc] = N;
     N->Loc = Loc;
 }
@@ -83,10 +123,11 @@ Node *HeapDeleteMin()
 
     if (!HeapCount)
         return 0;
-    Remove = Heap[1];
-    Heap[1] = Heap[HeapCount--];
-    Heap[1]->Loc = 1;
-    HeapSiftDown(Heap[1]);
+    Remove = Heap[HEAP_ROOT];
+    HeapCount--;
+    Heap[HEAP_ROOT] = Heap[HeapLast--];
+    Heap[HEAP_ROOT]->Loc = HEAP_ROOT;
+    HeapSiftDown(Heap[HEAP_ROOT]);
     Remove->Loc = 0;
     return Remove;
 }
@@ -111,7 +152,8 @@ void HeapDelete(Node * N)
     int Loc = N->Loc;
     if (!Loc)
         return;
-    Heap[Loc] = Heap[HeapCount--];
+    HeapCount--;
+    Heap[Loc] = Heap[HeapLast--];
     Heap[Loc]->Loc = Loc;
     if (Heap[Loc]->Rank > N->Rank)
         HeapSiftDown(Heap[Loc]);
@@ -130,8 +172,10 @@ void HeapDelete(Node * N)
 void HeapLazyInsert(Node * N)
 {
     assert(HeapCount < HeapCapacity);
-    Heap[++HeapCount] = N;
-    N->Loc = HeapCount;
+    HeapCount++;
+    Heap[++HeapLast] = N;
+    HeapRank[HeapLast] = N->Rank;
+    N->Loc = HeapLast;
 }
 
 /*       
@@ -141,6 +185,7 @@ void HeapLazyInsert(Node * N)
 void Heapify()
 {
     int Loc;
-    for (Loc = HeapCount / 2; Loc >= 1; Loc--)
-        HeapSiftDown(Heap[Loc]);
+    if (HeapCount > 1)
+        for (Loc = HeapParent(HeapLast); Loc >= HEAP_ROOT; Loc--)
+            HeapSiftDown(Heap[Loc]);
 }
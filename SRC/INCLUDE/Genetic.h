@@ -12,7 +12,8 @@ int PopulationSize;    /* The current size of the population */
 
 CrossoverFunction Crossover;
 
-int **Population;      /* Array of individuals (solution tours) */
+int **Population;      /* Array of individuals (solution tours), each
+                          stored as a successor array (see Genetic.c) */
 GainType *Fitness;     /* The fitness (tour cost) of each individual */
 
 void AddToPopulation(GainType Cost);
@@ -22,8 +23,10 @@ int HasFitness(GainType Cost);
 int LinearSelection(int Size, double Bias);
 GainType MergeTourWithIndividual(int i);
 void PrintPopulation();
+int ReadPopulation(FILE * f);
 void ReplaceIndividualWithTour(int i, GainType Cost);
 int ReplacementIndividual(GainType Cost);
+void WritePopulation(FILE * f);
 
 void ERXT();
 
@@ -33,9 +33,10 @@
 #define InBestTour(a, b) ((a)->BestSuc == (b) || (b)->BestSuc == (a))
 #define InNextBestTour(a, b)\
     ((a)->NextBestSuc == (b) || (b)->NextBestSuc == (a))
-#define InInputTour(a, b) ((a)->InputSuc == (b) || (b)->InputSuc == (a))
+#define InInputTour(a, b)\
+    (InputSucTable && (InputSuc(a) == (b) || InputSuc(b) == (a)))
 #define InInitialTour(a, b)\
-    ((a)->InitialSuc == (b) || (b)->InitialSuc == (a))
+    (InitialSucTable && (InitialSuc(a) == (b) || InitialSuc(b) == (a)))
 #define Near(a, b)\
     ((a)->BestSuc ? InBestTour(a, b) : (a)->Dad == (b) || (b)->Dad == (a))
 //链接节点(a,b)
@@ -47,6 +48,41 @@
     { Link((a)->Pred, (a)->Suc); Link(a, a); Link((b)->Pred, a); Link(a, b); }
 #define SLink(a, b) { (a)->Suc = (b); (b)->Pred = (a); }
 
+/* Node data that are only needed for certain features are kept in tables
+   indexed by node number (see NodeTable.c). A table is allocated only when
+   its feature is used; otherwise it is zero */
+#define InitialSuc(N) InitialSucTable[(N)->Id]
+#define InputSuc(N) InputSucTable[(N)->Id]
+#define MergeSuc(N, i)\
+    MergeSucTable[(size_t) (N)->Id * MergeTourFiles + (i)]
+#define SubproblemPred(N) SubproblemLinkTable[(N)->Id].Pred
+#define SubproblemSuc(N) SubproblemLinkTable[(N)->Id].Suc
+#define SubBestPred(N) SubproblemLinkTable[(N)->Id].BestPred
+#define SubBestSuc(N) SubproblemLinkTable[(N)->Id].BestSuc
+#define BackboneCandidateSet(N) BackboneCandidateTable[(N)->Id]
+#define Xc(N) ConvertedCoordTable[(N)->Id].Xc
+#define Yc(N) ConvertedCoordTable[(N)->Id].Yc
+#define Zc(N) ConvertedCoordTable[(N)->Id].Zc
+
+/* The index in CostMatrix8 or CostMatrix16 of the weight of the edge 
+   between the nodes numbered i and j (see CostMatrix.c) */
+#define CostIndex(i, j)\
+    ((i) > (j) ? (size_t) ((i) - 1) * ((i) - 2) / 2 + (j) - 1 :\
+     (size_t) ((j) - 1) * ((j) - 2) / 2 + (i) - 1)
+
+/* Conversion between internal node numbers and the node numbers used in
+   files (see RenumberNodes.c) */
+#define ExternalId(i) (ExternalIdTable ? ExternalIdTable[i] : (i))
+#define InternalId(i) (InternalIdTable ? InternalIdTable[i] : (i))
+
+/* Headers of binary CANDIDATE_FILEs and PI_FILEs. A file is written in
+   binary if its name ends with ".bin" (see WriteCandidates.c and
+   WritePenalties.c), and read in binary if it starts with the header */
+#define BINARY_CANDIDATE_HEADER "LKH binary candidates 1\n"
+#define BINARY_PI_HEADER "LKH binary penalties 2\n"
+#define BinaryFileName(s)\
+    (strlen(s) >= 4 && !strcmp((s) + strlen(s) - 4, ".bin"))
+
 /**
  * 这些宏是我自己定义的，用来控制打印。
  */
@@ -66,14 +102,28 @@ enum EdgeWeightFormats { FUNCTION, FULL_MATRIX, UPPER_ROW, LOWER_ROW,
     UPPER_DIAG_COL, LOWER_DIAG_COL
 };
 enum CandidateSetTypes { ALPHA, DELAUNAY, NN, QUADRANT };
+enum NodeOrders { INPUT_ORDER, INITIAL_TOUR_ORDER, MOORE_ORDER,
+    SIERPINSKI_ORDER
+};
 enum InitialTourAlgorithms { BORUVKA, GREEDY, MOORE, NEAREST_NEIGHBOR,
     QUICK_BORUVKA, SIERPINSKI, WALK
 };
+enum TreeTypes { ONE_LEVEL_LIST, TWO_LEVEL_LIST, THREE_LEVEL_LIST,
+    ARRAY_TOUR, BALANCED_TREE_TOUR
+};
 
 typedef struct Node Node;
 typedef struct Candidate Candidate;
 typedef struct Segment Segment;
 typedef struct SSegment SSegment;
+typedef struct BTNode BTNode;
+typedef struct CacheSet CacheSet;
+typedef struct TrigTerms TrigTerms;
+typedef struct SubproblemLinks SubproblemLinks;
+typedef struct ConvertedCoords ConvertedCoords;
+typedef struct Arena Arena;
+typedef struct Arena ArenaMark;
+typedef struct ArenaBlock ArenaBlock;
 typedef struct SwapRecord SwapRecord;
 typedef Node *(*MoveFunction) (Node * t1, Node * t2, GainType * G0,
                                GainType * Gain);
@@ -102,6 +152,11 @@ struct Node {
     int Beta;   /* Beta-value (used for computing alpha-values) */
     int Subproblem;  /* Number of the subproblem the node is part of */
     int Sons;   /* Number of sons in the minimum spanning tree */
+    char Axis;  /* The axis partitioned when the node is part of a KDTree */
+    char OldPredExcluded, OldSucExcluded;  /* Booleans used for indicating 
+                                              whether one (or both) of the 
+                                              adjoining nodes on the old tour 
+                                              has been excluded */
     int *C;     /* A row in the cost matrix */
     Node *Pred, *Suc;  /* Predecessor and successor node in 
                           the two-way list of nodes */
@@ -122,28 +177,14 @@ struct Node {
          *FixedTo2Saved;
     Node *Head; /* Head of a segment of common edges */
     Node *Tail; /* Tail of a segment of common edges */
-    Node *InputSuc;    /* Successor in the INPUT_TOUR file */
-    Node *InitialSuc;  /* Successor in the INITIAL_TOUR file */
-    Node *SubproblemPred; /* Predecessor in the SUBPROBLEM_TOUR file */
-    Node *SubproblemSuc;  /* Successor in the SUBPROBLEM_TOUR file */
-    Node *SubBestPred; /* The best predecessor node in a subproblem */
-    Node *SubBestSuc;  /* The best successor node in a subproblem */
-    Node **MergeSuc;   /* Successors in the MERGE_TOUR files */
     Node *Added1, *Added2; /* Pointers to the opposite end nodes
                               of added edges in a submove */
     Node *Deleted1, *Deleted2;  /* Pointers to the opposite end nodes
                                    of deleted edges in a submove */
     Candidate *CandidateSet;    /* Candidate array */
-    Candidate *BackboneCandidateSet; /* Backbone candidate array */
     Segment *Parent;   /* Parent segment of a node when the two-level
                           tree representation is used */
     double X, Y, Z;     /* Coordinates of the node */
-    double Xc, Yc, Zc;  /* Converted coordinates */
-    char Axis;  /* The axis partitioned when the node is part of a KDTree */
-    char OldPredExcluded, OldSucExcluded;  /* Booleans used for indicating 
-                                              whether one (or both) of the 
-                                              adjoining nodes on the old tour 
-                                              has been excluded */
 };
 
 /* The Candidate structure is used to represent candidate edges */
@@ -176,6 +217,87 @@ struct SSegment {
     int Size;   /* The number of nodes in the segment */
 };
 
+/* The BTNode structure is used to represent the nodes of the balanced tree
+   (a treap) of the balanced tree representation of tours. The tree nodes
+   are indexed by the Id of the corresponding tour nodes */
+
+struct BTNode {
+    int Left, Right;    /* Ids of the left and right child (0 if none) */
+    int Parent; /* Id of the parent (0 for the root) */
+    int Size;   /* Number of nodes in the subtree */
+    char Reversed;      /* Reversal bit of the subtree (lazily propagated) */
+    char Flipped;       /* Specifies whether Pred and Suc of the node are 
+                           interchanged */
+    char Orientation;   /* Cached result of Flipped_BT */
+    int Position;       /* Cached result of Position_BT */
+    unsigned Stamp;     /* The cached results are valid if Stamp equals 
+                           BTreeStamp */
+};
+
+/* The CacheSet structure is used to represent a set of the set-associative
+   distance cache (see C_FUNCTION). Each entry consists of a tag, in which 
+   the numbers of the two end nodes of an edge are packed, and the cached 
+   distance of the edge. A zero tag denotes an empty entry.
+
+   The sets are padded to a multiple of CACHE_LINE_SIZE bytes, and the 
+   cache is aligned at a cache line boundary (see LargeCalloc). With at 
+   most 5 ways, a lookup therefore touches a single cache line */
+
+#ifndef CACHE_WAYS
+#define CACHE_WAYS 4
+#endif
+
+#define CACHE_LINE_SIZE 64
+
+#ifdef __GNUC__
+#define CACHE_LINE_ALIGNED __attribute__ ((aligned(CACHE_LINE_SIZE)))
+#else
+#define CACHE_LINE_ALIGNED
+#endif
+
+struct CacheSet {
+    unsigned long long Tag[CACHE_WAYS]; /* Packed node numbers */
+    int Val[CACHE_WAYS];        /* Cached distances */
+} CACHE_LINE_ALIGNED;
+
+/* The TrigTerms structure is used to hold the latitude and longitude of a
+   node (in radians) together with their sines and cosines, and the sines 
+   and cosines of their halves. The terms are used by the GEO, GEOM, 
+   GEO_MEEUS and GEOM_MEEUS distance functions */
+
+struct TrigTerms {
+    double Lat, Lon;
+    double SinLat, CosLat, SinLon, CosLon;
+    double SinHalfLat, CosHalfLat, SinHalfLon, CosHalfLon;
+};
+
+/* The SubproblemLinks structure is used to hold the links of a node in 
+   subproblem mode (see SubproblemLinkTable) */
+
+struct SubproblemLinks {
+    Node *Pred, *Suc;   /* Predecessor and successor in the 
+                           SUBPROBLEM_TOUR file */
+    Node *BestPred, *BestSuc;   /* The best predecessor and successor 
+                                   node in a subproblem */
+};
+
+/* The ConvertedCoords structure is used to hold the coordinates of a node 
+   while they are temporarily converted (see ConvertedCoordTable) */
+
+struct ConvertedCoords {
+    double Xc, Yc, Zc;
+};
+
+/* The Arena structure is used to represent an arena (region) of memory
+   (see Arena.c). Space is allocated from the current block. A mark of an 
+   arena (an ArenaMark) is a copy of its Block and Used fields */
+
+struct Arena {
+    ArenaBlock *Block;  /* The current block */
+    size_t Used;        /* Number of bytes used in the current block */
+    ArenaBlock *Spare;  /* List of blocks that may be reused */
+};
+
 /* The SwapRecord structure is used to record 2-opt moves (swaps) */
 
 struct SwapRecord {
@@ -184,6 +306,8 @@ struct SwapRecord {
 
 int AscentCandidates;   /* Number of candidate edges to be associated
                            with each node during the ascent */
+Candidate **BackboneCandidateTable;     /* Backbone candidate arrays 
+                                           (during backbone trials) */
 int BackboneTrials;     /* Number of backbone trials in each run */
 int Backtracking;       /* Specifies whether backtracking is used for 
                            the first move in a sequence of moves */
@@ -192,18 +316,43 @@ int *BestTour;  /* Table containing best tour found */
 GainType BetterCost;    /* Cost of the tour stored in BetterTour */
 int *BetterTour;        /* Table containing the currently best tour 
                            in a run */
-int CacheMask;  /* Mask for indexing the cache */
-int *CacheVal;  /* Table of cached distances */
-int *CacheSig;  /* Table of the signatures of cached 
-                   distances */
+BTNode *BTree;  /* The tree nodes when the balanced tree representation
+                   is used */
+int BTreeRoot;  /* Id of the root of the balanced tree */
+unsigned BTreeStamp;    /* Incremented each time the balanced tree is 
+                           changed */
+double CacheHits, CacheMisses;  /* Number of hits and misses in the 
+                                   distance cache */
+int CacheMask;  /* Mask for indexing the sets of the cache */
+CacheSet *DistanceCache;        /* The sets of the distance cache */
+int DistanceCacheSize;  /* Requested number of entries of the cache */
+int DistanceLibraryMemoSize;    /* Maximum number of distances kept from
+                                   the DISTANCE_LIBRARY (0: no limit) */
 int CandidateFiles;     /* Number of CANDIDATE_FILEs */
+int CheckpointInterval; /* Number of runs between checkpoints */
+int CheckpointTrials;   /* Number of trials between checkpoints within a
+                           run (0: no checkpoints within runs) */
+int ConvertOnly;        /* Specifies whether the program stops after
+                           writing the BINARY_PROBLEM_FILE */
+ConvertedCoords *ConvertedCoordTable;   /* Saved or converted coordinates 
+                                           (for geographical coordinates
+                                           or K-means partitioning) */
 int *CostMatrix;        /* Cost matrix */
+unsigned char *CostMatrix8;     /* Cost matrix with 8-bit entries */
+unsigned short *CostMatrix16;   /* Cost matrix with 16-bit entries */
+int CostMatrixOffset;   /* Offset of the entries of CostMatrix8 and
+                           CostMatrix16 */
+int CostMatrixWidth;    /* Maximum number of bits per entry of a 
+                           symmetric cost matrix */
 int Dimension;  /* Number of nodes in the problem */
 int DimensionSaved;     /* Saved value of Dimension */
+int Euc2DSinglePrecision;       /* Specifies whether EUC_2D distances are
+                                   computed in single precision */
 double Excess;  /* Maximum alpha-value allowed for any 
                    candidate edge is set to Excess times the 
                    absolute value of the lower bound of a 
                    solution tour */
+int *ExternalIdTable;   /* Node numbers in files of renumbered nodes */
 int ExtraCandidates;    /* Number of extra neighbors to be added to 
                            the candidate set of each node */
 Node *FirstActive, *LastActive; /* First and last node in the list 
@@ -213,6 +362,11 @@ Segment *FirstSegment;  /* A pointer to the first segment in the cyclic
                            list of segments */
 SSegment *FirstSSegment;        /* A pointer to the first super segment in
                                    the cyclic list of segments */
+int FlipSampling;       /* Specifies whether the lengths of 2-opt moves 
+                           are sampled for tuning the segment sizes */
+Node *Gain23Node;       /* The node at which the next search of Gain23
+                           starts */
+int Gain23Reversed;     /* The orientation of the next search of Gain23 */
 int Gain23Used; /* Specifies whether Gain23 is used */
 int GainCriterionUsed;  /* Specifies whether L&K's gain criterion is 
                            used */
@@ -224,10 +378,15 @@ unsigned Hash;  /* Hash value corresponding to the current tour */
 Node **Heap;    /* Heap used for computing minimum spanning 
                    trees */
 HashTable *HTable;      /* Hash table used for storing tours */
+int HugePages;  /* Specifies whether large arrays are backed by
+                   transparent huge pages */
 int InitialPeriod;      /* Length of the first period in the ascent */
 int InitialStepSize;    /* Initial step size used in the ascent */
+Node **InitialSucTable; /* Successors in the INITIAL_TOUR file */
 double InitialTourFraction;     /* Fraction of the initial tour to be 
                                    constructed by INITIAL_TOUR_FILE edges */
+Node **InputSucTable;   /* Successors in the INPUT_TOUR file */
+int *InternalIdTable;   /* Inverse of ExternalIdTable */
 char *LastLine; /* Last input line */
 double LowerBound;      /* Lower bound found by the ascent */
 int Kicks;      /* Specifies the number of K-swap-kicks */
@@ -243,12 +402,18 @@ int MaxMatrixDimension; /* Maximum dimension for an explicit cost matrix */
 int MaxSwaps;   /* Maximum number of swaps made during the 
                    search for a move */
 int MaxTrials;  /* Maximum number of trials in each run */
+double MemoryLimit;     /* Maximum number of megabytes for a cost
+                           matrix computed from node coordinates */
+Node **MergeSucTable;   /* Successors in the MERGE_TOUR files 
+                           (MergeTourFiles entries per node) */
 int MergeTourFiles;     /* Number of MERGE_TOUR_FILEs */
 int MoveType;   /* Specifies the sequantial move type to be used 
                    in local search. A value K >= 2 signifies 
                    that a k-opt moves are tried for k <= K */
 Node *NodeSet;  /* Array of all nodes */
 int Norm;       /* Measure of a 1-tree's discrepancy from a tour */
+int NUMAInterleave;     /* Specifies whether the pages of large arrays
+                           are interleaved over the NUMA nodes */
 int NonsequentialMoveType;      /* Specifies the nonsequential move type to
                                    be used in local search. A value 
                                    L >= 4 signifies that nonsequential
@@ -267,15 +432,29 @@ int PredSucCostAvailable; /* PredCost and SucCost are available */
 unsigned *Rand; /* Table of random values */
 int RestrictedSearch;   /* Specifies whether the choice of the first 
                            edge to be broken is restricted */
+int Resume;     /* Specifies whether the search is resumed from
+                   the CHECKPOINT_FILE */
+int ResumeTrial;        /* Last trial of a run that is resumed within the
+                           run (0: the run is started from the beginning) */
+double ResumeTime;      /* Time used by the resumed run before the
+                           checkpoint */
 short Reversed; /* Boolean used to indicate whether a tour has 
                    been reversed */
 int Run; /* Current run number */
 int Runs;       /* Total number of runs */
+Arena ScratchArena;     /* Arena for temporary arrays and for the data of
+                           the subproblem being solved */
 unsigned Seed;  /* Initial seed for random number generation */
+Arena SegmentArena;     /* Arena for the segments and super segments */
+int SegmentTuningTrials;        /* Number of trials in which the lengths
+                                   of 2-opt moves are sampled for tuning
+                                   the segment sizes */
 int StopAtOptimum;      /* Specifies whether a run will be terminated if 
                            the tour length becomes equal to Optimum */
 int Subgradient;        /* Specifies whether the Pi-values should be 
                            determined by subgradient optimization */
+SubproblemLinks *SubproblemLinkTable;   /* Links used in subproblem 
+                                           mode */
 int SubproblemSize;     /* Number of nodes in a subproblem */
 int SubsequentMoveType; /* Specifies the move type to be used for all 
                            moves following the first move in a sequence 
@@ -286,11 +465,19 @@ int SubsequentPatching; /* Species whether patching is used for
 SwapRecord *SwapStack;  /* Stack of SwapRecords */
 int Swaps;      /* Number of swaps made during a tentative move */
 double TimeLimit;       /* The time limit in seconds for each run */
+TrigTerms *Trig;        /* Table of trigonometric terms of the nodes 
+                           (indexed by node number) */
 int TraceLevel; /* Specifies the level of detail of the output 
                    given during the solution process. 
                    The value 0 signifies a minimum amount of 
                    output. The higher the value is the more 
                    information is given */
+Node **TourArray;       /* The tour when the array representation is
+                           used. The Rank of a node is its index */
+int TreeType;   /* Specifies the tour representation (see Segment.h). 
+                   The value -1 signifies that the representation is 
+                   chosen from the dimension of the problem */
+int CurrentTreeType;    /* The tour representation currently in use */
 int Trial;      /* Ordinal number of the current trial */
 
 /* The following variables are read by the functions ReadParameters and 
@@ -299,7 +486,8 @@ int Trial;      /* Ordinal number of the current trial */
 char *ParameterFileName, *ProblemFileName, *PiFileName,
     *TourFileName, *OutputTourFileName, *InputTourFileName,
     **CandidateFileName, *InitialTourFileName,
-    *SubproblemTourFileName, **MergeTourFileName;
+    *SubproblemTourFileName, **MergeTourFileName, *CostMatrixFileName,
+    *DistanceLibraryName, *BinaryProblemFileName, *CheckpointFileName;
 char *Name, *Type, *EdgeWeightType, *EdgeWeightFormat,
     *EdgeDataFormat, *NodeCoordType, *DisplayDataType;
 int CandidateSetSymmetric, CandidateSetType,
@@ -307,7 +495,7 @@ int CandidateSetSymmetric, CandidateSetType,
     ExtraCandidateSetSymmetric, ExtraCandidateSetType,
     InitialTourAlgorithm,
     KarpPartitioning, KCenterPartitioning, KMeansPartitioning,
-    MoorePartitioning,
+    MoorePartitioning, NodeOrder,
     PatchingAExtended, PatchingARestricted,
     PatchingCExtended, PatchingCRestricted,
     ProblemType,
@@ -327,12 +515,16 @@ int Distance_ATT(Node * Na, Node * Nb);
 int Distance_CEIL_2D(Node * Na, Node * Nb);
 int Distance_CEIL_3D(Node * Na, Node * Nb);
 int Distance_EXPLICIT(Node * Na, Node * Nb);
+int Distance_EXPLICIT_8(Node * Na, Node * Nb);
+int Distance_EXPLICIT_16(Node * Na, Node * Nb);
 int Distance_EUC_2D(Node * Na, Node * Nb);
+int Distance_EUC_2D_FLOAT(Node * Na, Node * Nb);
 int Distance_EUC_3D(Node * Na, Node * Nb);
 int Distance_GEO(Node * Na, Node * Nb);
 int Distance_GEOM(Node * Na, Node * Nb);
 int Distance_GEO_MEEUS(Node * Na, Node * Nb);
 int Distance_GEOM_MEEUS(Node * Na, Node * Nb);
+int Distance_LIBRARY(Node * Na, Node * Nb);
 int Distance_MAN_2D(Node * Na, Node * Nb);
 int Distance_MAN_3D(Node * Na, Node * Nb);
 int Distance_MAX_2D(Node * Na, Node * Nb);
@@ -342,9 +534,15 @@ int Distance_XRAY1(Node * Na, Node * Nb);
 int Distance_XRAY2(Node * Na, Node * Nb);
 
 int D_EXPLICIT(Node * Na, Node * Nb);
+int D_EXPLICIT_8(Node * Na, Node * Nb);
+int D_EXPLICIT_16(Node * Na, Node * Nb);
+int D_EXPLICIT_32(Node * Na, Node * Nb);
 int D_FUNCTION(Node * Na, Node * Nb);
 
 int C_EXPLICIT(Node * Na, Node * Nb);
+int C_EXPLICIT_8(Node * Na, Node * Nb);
+int C_EXPLICIT_16(Node * Na, Node * Nb);
+int C_EXPLICIT_32(Node * Na, Node * Nb);
 int C_FUNCTION(Node * Na, Node * Nb);
 
 int c_ATT(Node * Na, Node *Nb);
@@ -356,15 +554,26 @@ int c_GEO(Node * Na, Node * Nb);
 int c_GEOM(Node * Na, Node * Nb);
 int c_GEO_MEEUS(Node * Na, Node * Nb);
 int c_GEOM_MEEUS(Node * Na, Node * Nb);
+int c_MAN_2D(Node * Na, Node * Nb);
+int c_MAN_3D(Node * Na, Node * Nb);
+int c_MAX_2D(Node * Na, Node * Nb);
+int c_MAX_3D(Node * Na, Node * Nb);
+int c_XRAY1(Node * Na, Node * Nb);
+int c_XRAY2(Node * Na, Node * Nb);
 
 void Activate(Node * t);
 int AddCandidate(Node * From, Node * To, int Cost, int Alpha);
 void AddExtraCandidates(int K, int CandidateSetType, int Symmetric);
 void AddTourCandidates(void);
 void AdjustCandidateSet(void);
+void AllocateCostMatrix(void);
+void *AllocateNodeTable(size_t Size);
 void AllocateSegments(void);
 void AllocateStructures(void);
+void *ArenaAlloc(Arena * A, size_t Size);
+void *ArenaCalloc(Arena * A, size_t Count, size_t Size);
 GainType Ascent(void);
+int BatchableDistance(void);
 Node *Best2OptMove(Node * t1, Node * t2, GainType * G0, GainType * Gain);
 Node *Best3OptMove(Node * t1, Node * t2, GainType * G0, GainType * Gain);
 Node *Best4OptMove(Node * t1, Node * t2, GainType * G0, GainType * Gain);
@@ -373,28 +582,48 @@ Node *BestKOptMove(Node * t1, Node * t2, GainType * G0, GainType * Gain);
 int Between(const Node * ta, const Node * tb, const Node * tc);
 int Between_SL(const Node * ta, const Node * tb, const Node * tc);
 int Between_SSL(const Node * ta, const Node * tb, const Node * tc);
+int Between_BT(const Node * ta, const Node * tb, const Node * tc);
 GainType BridgeGain(Node * s1, Node * s2, Node * s3, Node * s4,
                     Node * s5, Node * s6, Node * s7, Node * s8,
                     int Case6, GainType G);
+void BuildBTree(void);
 Node **BuildKDTree(int Cutoff);
+int BytesPerNode(void);
 void ChooseInitialTour(void);
+void ChooseTreeType(void);
+void CloseInputFile(FILE * f);
 void Connect(Node * N1, int Max, int Sparse);
 void CandidateReport(void);
+void CompressCostMatrix(void);
+void ComputeTrigTerms(void);
+void CostMatrixRange(int *Min, int *Max);
 void CreateCandidateSet(void);
 void CreateDelaunayCandidateSet(void);
 void CreateNearestNeighborCandidateSet(int K);
 void CreateQuadrantCandidateSet(int K);
+void DistanceBatch(Node * Na, Node ** Nb, int Count, int *D);
+void DistanceBatchXYZ(Node * Na, const double *X, const double *Y,
+                      const double *Z, int Count, int *D);
+void DistanceLibraryBatch(Node * Na, Node ** Nb, int Count, int *D);
 void eprintf(const char *fmt, ...);
 int Excludable(Node * ta, Node * tb);
 void Exclude(Node * ta, Node * tb);
 GainType FindTour(void);
 void Flip(Node * t1, Node * t2, Node * t3);
+void Flip_A(Node * t1, Node * t2, Node * t3);
 void Flip_SL(Node * t1, Node * t2, Node * t3);
 void Flip_SSL(Node * t1, Node * t2, Node * t3);
+void Flip_BT(Node * t1, Node * t2, Node * t3);
+int Flipped_BT(const Node * t);
 int Forbidden(const Node * ta, const Node * tb);
+void FreeArena(Arena * A);
 void FreeCandidateSets(void);
+void FreeCostMatrix(void);
+void FreeDistanceLibrary(void);
 void FreeSegments(void);
+void FreeSegmentLists(void);
 void FreeStructures(void);
+int fscandouble(FILE *f, double *v);
 int fscanint(FILE *f, int *v);
 GainType Gain23(void);
 void GenerateCandidates(int MaxCandidates, GainType MaxAlpha, int Symmetric);
@@ -406,7 +635,10 @@ int IsCandidate(const Node * ta, const Node * tb);
 int IsCommonEdge(const Node * ta, const Node * tb);
 int IsPossibleCandidate(Node * From, Node * To);
 void KSwapKick(int K);
+void *LargeCalloc(size_t Count, size_t Size);
+void LargeFree(void *P);
 GainType LinKernighan(void);
+void LoadDistanceLibrary(void);
 void Make2OptMove(Node * t1, Node * t2, Node * t3, Node * t4);
 void Make3OptMove(Node * t1, Node * t2, Node * t3, Node * t4, 
                   Node * t5, Node * t6, int Case);
@@ -417,32 +649,54 @@ void Make5OptMove(Node * t1, Node * t2, Node * t3, Node * t4,
                   Node * t5, Node * t6, Node * t7, Node * t8,
                   Node * t9, Node * t10, int Case);
 void MakeKOptMove(int K);
+void MapCostMatrix(void *Data, size_t Length, size_t Position, int Width,
+                   int Offset, int Min, int Max);
+ArenaMark MarkArena(Arena * A);
 GainType MergeTourWithBestTour(void);
 GainType MergeWithTour(void);
 GainType Minimum1TreeCost(int Sparse);
 void MinimumSpanningTree(int Sparse);
+int MooreIndex(double x, double y);
+void NodeTrigTerms(Node * N, TrigTerms * T);
 void NormalizeNodeList(void);
 void NormalizeSegmentList(void);
+FILE *OpenInputFile(char *FileName);
 void OrderCandidateSet(int MaxCandidates, 
                        GainType MaxAlpha, int Symmetric);
+void PartitionSegments(void);
 GainType PatchCycles(int k, GainType Gain);
 void printff(char *fmt, ...);
+int Position_BT(const Node * t);
 void PrintParameters(void);
 void PrintStatistics(void);
 unsigned Random(void);
 int ReadCandidates(int MaxCandidates);
+int ReadCheckpoint(void);
+int ReadCostMatrix(void);
+int ReadInputBytes(FILE * f, void *v, size_t Size);
+int ReadInputHeader(FILE * f, const char *Header);
 char *ReadLine(FILE * InputFile);
 void ReadParameters(void);
 int ReadPenalties(void);
 void ReadProblem(void);
+int ReadRandomState(FILE * f);
+int ReadStatistics(FILE * f);
 void ReadTour(char * FileName, FILE ** File);
 void RecordBestTour(void);
 void RecordBetterTour(void);
 Node *RemoveFirstActive(void);
+void ReleaseArena(Arena * A, ArenaMark M);
+void RenumberNodes(void);
+void ResetArena(Arena * A);
 void ResetCandidateSet(void);
 void RestoreTour(void);
+void SampleFlip(int Length);
+int ScanInt(FILE * f, int Binary, int *v);
 int SegmentSize(Node *ta, Node *tb);
+int SegmentSize_SL(Node *ta, Node *tb);
+int SegmentSize_SSL(Node *ta, Node *tb);
 GainType SFCTour(int CurveType);
+int SierpinskiIndex(double x, double y);
 void SolveCompressedSubproblem(int CurrentSubproblem, int Subproblems, 
                                GainType * GlobalBestCost);
 void SolveDelaunaySubproblems(void);
@@ -455,13 +709,21 @@ int SolveSubproblem(int CurrentSubproblem, int Subproblems,
                     GainType * GlobalBestCost);
 void SolveSubproblemBorderProblems(int Subproblems, GainType * GlobalCost);
 void SolveTourSegmentSubproblems(void);
+void StoreCost(Node * N, int j, int W);
+int StoredCost(Node * N, int j);
 void StoreTour(void);
 void SRandom(unsigned seed);
+void StartFlipSampling(void);
 void SymmetrizeCandidateSet(void);
 void TrimCandidateSet(int MaxCandidates);
+void TuneSegments(void);
 void UpdateStatistics(GainType Cost, double Time);
 void WriteCandidates(void);
+void WriteCheckpoint(int InRun, double RunTime);
+void WriteCostMatrix(void);
 void WritePenalties(void);
+void WriteRandomState(FILE * f);
+void WriteStatistics(FILE * f);
 void WriteTour(char * FileName, int * Tour, GainType Cost);
 
 #endif
@@ -1,21 +1,15 @@
 #ifndef _SEGMENT_H
 #define _SEGMENT_H
 
-#ifndef ONE_LEVEL_TREE
-#ifndef TWO_LEVEL_TREE
-#ifndef THREE_LEVEL_TREE
-#define TWO_LEVEL_TREE
-#endif
-#endif
-#endif
-
 /*
  * This header specifies the interface for accessing and manipulating a
  * tour. 
  *
- * If THREE_LEVEL_TREE is defined the three-level tree representation is used
- * for a tour.  If TWO_LEVEL_TREE is defined the three-level tree 
- * representation is used.  Otherwise the linked list representation is used. 
+ * Five tour representations are available: the linked list representation,
+ * the two-level tree representation, the three-level tree representation,
+ * the array representation, and the balanced tree representation. The
+ * representation to be used is chosen at run time (see the ChooseTreeType
+ * function).
  *
  * All representations support the following primitive operations:
  *
@@ -29,34 +23,112 @@
  *         in the tour with respect to a chosen orientation (BETWEEN);
  *
  *     (4) make a 2-opt move (FLIP).
- *	
- * The default representation is the two-level tree representation. 
- * In order to use the linked list representation, uncomment the 
- * following preprocessor command line.	
+ *
+ * The functions that use these operations are compiled once for each
+ * representation (see the Makefile). If ONE_LEVEL_TREE, TWO_LEVEL_TREE, 
+ * THREE_LEVEL_TREE, ARRAY_TREE or BALANCED_TREE is defined, the operations
+ * are bound to the corresponding representation, and each externally
+ * visible function of the compilation unit is given the suffix _LL, _SL,
+ * _SSL, _A or _BT, respectively (e.g., LinKernighan_SL). In this way the hot functions call each other 
+ * directly, without any run time dispatching. 
+ *
+ * The macros PRED_LL, SUC_LL, PRED_SL, SUC_SL, PRED_SSL, SUC_SSL, PRED_BT
+ * and SUC_BT are always available.
  */
 
-#ifdef THREE_LEVEL_TREE
-#define PRED(a)\
+/* Segments are split if the path to be reversed within a segment exceeds
+   SPLIT_CUTOFF times the desired size of the segment (see Flip_SL) */
+
+#define SPLIT_CUTOFF 0.75
+
+#define PRED_LL(a) (Reversed ? (a)->Suc : (a)->Pred)
+#define SUC_LL(a) (Reversed ? (a)->Pred : (a)->Suc)
+#define PRED_SL(a) (Reversed == (a)->Parent->Reversed ? (a)->Pred : (a)->Suc)
+#define SUC_SL(a) (Reversed == (a)->Parent->Reversed ? (a)->Suc : (a)->Pred)
+#define PRED_SSL(a)\
     (Reversed == ((a)->Parent->Reversed != (a)->Parent->Parent->Reversed) ?\
     (a)->Pred : (a)->Suc)
-#define SUC(a)\
+#define SUC_SSL(a)\
     (Reversed == ((a)->Parent->Reversed != (a)->Parent->Parent->Reversed) ?\
     (a)->Suc : (a)->Pred)
+#define PRED_BT(a) (Reversed == Flipped_BT(a) ? (a)->Pred : (a)->Suc)
+#define SUC_BT(a) (Reversed == Flipped_BT(a) ? (a)->Suc : (a)->Pred)
+
+/* The cost of the tour edge (a,b), where b is one of a's two neighbors on
+   the tour. The Pi-transformed costs of the tour edges are kept in PredCost
+   and SucCost while PredSucCostAvailable is 1 (see LinKernighan) */
+
+#define TOUR_COST(a, b) ((a)->Suc == (b) ? (a)->SucCost : (a)->PredCost)
+
+#ifdef THREE_LEVEL_TREE
+#define TREE_SUFFIX _SSL
+#define PRED(a) PRED_SSL(a)
+#define SUC(a) SUC_SSL(a)
 #define BETWEEN(a, b, c) Between_SSL(a, b, c)
 #define FLIP(a, b, c, d) Flip_SSL(a, b, c)
 #endif
 #ifdef TWO_LEVEL_TREE
-#define PRED(a) (Reversed == (a)->Parent->Reversed ? (a)->Pred : (a)->Suc)
-#define SUC(a) (Reversed == (a)->Parent->Reversed ? (a)->Suc : (a)->Pred)
+#define TREE_SUFFIX _SL
+#define PRED(a) PRED_SL(a)
+#define SUC(a) SUC_SL(a)
 #define BETWEEN(a, b, c) Between_SL(a, b, c)
 #define FLIP(a, b, c, d) Flip_SL(a, b, c)
 #endif
 #ifdef ONE_LEVEL_TREE
-#define PRED(a) (Reversed ? (a)->Suc : (a)->Pred)
-#define SUC(a) (Reversed ? (a)->Pred : (a)->Suc)
+#define TREE_SUFFIX _LL
+#define PRED(a) PRED_LL(a)
+#define SUC(a) SUC_LL(a)
 #define BETWEEN(a, b, c) Between(a, b, c)
 #define FLIP(a, b, c, d) Flip(a, b, c)
 #endif
+#ifdef ARRAY_TREE
+#define TREE_SUFFIX _A
+#define PRED(a) PRED_LL(a)
+#define SUC(a) SUC_LL(a)
+#define BETWEEN(a, b, c) Between(a, b, c)
+#define FLIP(a, b, c, d) Flip_A(a, b, c)
+#endif
+#ifdef BALANCED_TREE
+#define TREE_SUFFIX _BT
+#define PRED(a) PRED_BT(a)
+#define SUC(a) SUC_BT(a)
+#define BETWEEN(a, b, c) Between_BT(a, b, c)
+#define FLIP(a, b, c, d) Flip_BT(a, b, c)
+#endif
+
+#ifdef TREE_SUFFIX
+#define TREE_NAME(f) TREE_PASTE(f, TREE_SUFFIX)
+#define TREE_PASTE(f, s) TREE_PASTE2(f, s)
+#define TREE_PASTE2(f, s) f ## s
+
+#define Added TREE_NAME(Added)
+#define Best2OptMove TREE_NAME(Best2OptMove)
+#define Best3OptMove TREE_NAME(Best3OptMove)
+#define Best4OptMove TREE_NAME(Best4OptMove)
+#define Best5OptMove TREE_NAME(Best5OptMove)
+#define BestKOptMove TREE_NAME(BestKOptMove)
+#define BridgeGain TREE_NAME(BridgeGain)
+#define Cycles TREE_NAME(Cycles)
+#define Deleted TREE_NAME(Deleted)
+#define FeasibleKOptMove TREE_NAME(FeasibleKOptMove)
+#define FindPermutation TREE_NAME(FindPermutation)
+#define Gain23 TREE_NAME(Gain23)
+#define LinKernighan TREE_NAME(LinKernighan)
+#define Make2OptMove TREE_NAME(Make2OptMove)
+#define Make3OptMove TREE_NAME(Make3OptMove)
+#define Make4OptMove TREE_NAME(Make4OptMove)
+#define Make5OptMove TREE_NAME(Make5OptMove)
+#define MakeKOptMove TREE_NAME(MakeKOptMove)
+#define MarkAdded TREE_NAME(MarkAdded)
+#define MarkDeleted TREE_NAME(MarkDeleted)
+#define NormalizeNodeList TREE_NAME(NormalizeNodeList)
+#define PatchCycles TREE_NAME(PatchCycles)
+#define RestoreTour TREE_NAME(RestoreTour)
+#define SegmentSize TREE_NAME(SegmentSize)
+#define StoreTour TREE_NAME(StoreTour)
+#define UnmarkAdded TREE_NAME(UnmarkAdded)
+#define UnmarkDeleted TREE_NAME(UnmarkDeleted)
+#endif
 
 #define Swap1(a1,a2,a3)\
         FLIP(a1,a2,a3,0)
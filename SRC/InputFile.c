@@ -0,0 +1,367 @@
+#include "LKH.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ * The functions in this file read the input files: the PROBLEM_FILE, the
+ * tour files and the CANDIDATE_FILEs.
+ *
+ * A file opened by OpenInputFile is mapped into memory (mmap), and ReadLine,
+ * fscanint and fscandouble parse the mapped bytes directly. A file that
+ * cannot be mapped (e.g., a pipe), and any file not opened by
+ * OpenInputFile (e.g., stdin), is read through the stream, character by
+ * character.
+ *
+ * A file opened by OpenInputFile must be closed by CloseInputFile.
+ *
+ * Binary files (e.g., binary CANDIDATE_FILEs) are read by ReadInputHeader
+ * and ReadInputBytes, which copy the mapped bytes, or read them from the
+ * stream if the file is not mapped.
+ */
+
+#define MAX_MAPPED 8
+
+typedef struct MappedFile {
+    FILE *File;                 /* The stream, 0 if the entry is unused */
+    char *Data;                 /* Start of the mapped bytes */
+    size_t Size;                /* Number of mapped bytes */
+    const char *Pos;            /* Next byte to be read */
+    const char *End;            /* End of the mapped bytes */
+} MappedFile;
+
+static MappedFile Mapped[MAX_MAPPED];
+static MappedFile *Last;        /* Most recently used entry */
+static char *Buffer;            /* The line returned by ReadLine */
+static int MaxBuffer;           /* Size of Buffer */
+
+static MappedFile *FindMapped(FILE * f);
+static void SaveLine(const char *Line, int Length);
+static double Power10(int e);
+
+FILE *OpenInputFile(char *FileName)
+{
+    FILE *f;
+    struct stat Stat;
+    MappedFile *M = 0;
+    void *Data;
+    int i;
+
+    if (!(f = fopen(FileName, "r")))
+        return 0;
+    if (fstat(fileno(f), &Stat) || !S_ISREG(Stat.st_mode) ||
+        Stat.st_size == 0)
+        return f;
+    for (i = 0; i < MAX_MAPPED && !M; i++)
+        if (!Mapped[i].File)
+            M = &Mapped[i];
+    if (!M ||
+        (Data = mmap(0, (size_t) Stat.st_size, PROT_READ, MAP_PRIVATE,
+                     fileno(f), 0)) == MAP_FAILED)
+        return f;
+#ifdef MADV_SEQUENTIAL
+    madvise(Data, (size_t) Stat.st_size, MADV_SEQUENTIAL);
+#endif
+    M->File = f;
+    M->Data = (char *) Data;
+    M->Size = (size_t) Stat.st_size;
+    M->Pos = M->Data;
+    M->End = M->Data + M->Size;
+    return f;
+}
+
+void CloseInputFile(FILE * f)
+{
+    MappedFile *M;
+
+    if ((M = FindMapped(f))) {
+        munmap(M->Data, M->Size);
+        M->File = 0;
+        Last = 0;
+    }
+    fclose(f);
+}
+
+static MappedFile *FindMapped(FILE * f)
+{
+    int i;
+
+    if (Last && Last->File == f)
+        return Last;
+    for (i = 0; i < MAX_MAPPED; i++)
+        if (Mapped[i].File == f)
+            return Last = &Mapped[i];
+    return 0;
+}
+
+/*
+ * The ReadInputHeader function returns 1 if the unread part of a file
+ * starts with Header, and skips the header; otherwise it returns 0. A file
+ * that is not mapped is peeked at through the stream and, if it does not
+ * start with Header, rewound to where it was. A stream that cannot be
+ * rewound (e.g., a pipe) is never regarded as having a header.
+ */
+
+int ReadInputHeader(FILE * f, const char *Header)
+{
+    MappedFile *M = FindMapped(f);
+    size_t Length = strlen(Header);
+    char *Bytes;
+    long Pos;
+    int Match;
+
+    if (!M) {
+        if ((Pos = ftell(f)) < 0)
+            return 0;
+        assert(Bytes = (char *) malloc(Length));
+        Match = fread(Bytes, 1, Length, f) == Length &&
+            !memcmp(Bytes, Header, Length);
+        free(Bytes);
+        if (!Match && fseek(f, Pos, SEEK_SET))
+            eprintf("Cannot rewind input file");
+        return Match;
+    }
+    if ((size_t) (M->End - M->Pos) < Length ||
+        memcmp(M->Pos, Header, Length))
+        return 0;
+    M->Pos += Length;
+    return 1;
+}
+
+/*
+ * The ReadInputBytes function copies the next Size bytes of a file to v.
+ * It returns 1 if Size bytes could be read; otherwise 0.
+ */
+
+int ReadInputBytes(FILE * f, void *v, size_t Size)
+{
+    MappedFile *M = FindMapped(f);
+
+    if (!M)
+        return fread(v, 1, Size, f) == Size;
+    if ((size_t) (M->End - M->Pos) < Size)
+        return 0;
+    memcpy(v, M->Pos, Size);
+    M->Pos += Size;
+    return 1;
+}
+
+/*
+ * The ScanInt function reads the next int from a text or a binary file.
+ */
+
+int ScanInt(FILE * f, int Binary, int *v)
+{
+    return Binary ? ReadInputBytes(f, v, sizeof(int)) : fscanint(f, v);
+}
+
+/*
+ * The ReadLine function reads the next input line from a file. The function
+ * handles the problem that an input line may be terminated by a carriage
+ * return, a newline, both, or EOF.
+ *
+ * The line is copied to LastLine, which is printed by eprintf.
+ */
+
+static int EndOfLine(FILE * InputFile, int c)
+{
+    int EOL = (c == '\r' || c == '\n');
+    if (c == '\r') {
+        c = fgetc(InputFile);
+        if (c != '\n' && c != EOF)
+            ungetc(c, InputFile);
+    }
+    return EOL;
+}
+
+char *ReadLine(FILE * InputFile)
+{
+    MappedFile *M;
+    const char *Line;
+    int i, c;
+
+    if ((M = FindMapped(InputFile))) {
+        if (M->Pos == M->End)
+            return 0;
+        for (Line = M->Pos; M->Pos < M->End &&
+             *M->Pos != '\n' && *M->Pos != '\r'; M->Pos++);
+        SaveLine(Line, (int) (M->Pos - Line));
+        if (M->Pos < M->End && *M->Pos++ == '\r' &&
+            M->Pos < M->End && *M->Pos == '\n')
+            M->Pos++;
+        return Buffer;
+    }
+    if (Buffer == 0)
+        assert(Buffer = (char *) malloc(MaxBuffer = 80));
+    for (i = 0; (c = fgetc(InputFile)) != EOF && !EndOfLine(InputFile, c);
+         i++) {
+        if (i >= MaxBuffer - 1) {
+            MaxBuffer *= 2;
+            assert(Buffer = (char *) realloc(Buffer, MaxBuffer));
+        }
+        Buffer[i] = (char) c;
+    }
+    Buffer[i] = '\0';
+    SaveLine(Buffer, i);
+    return c == EOF && i == 0 ? 0 : Buffer;
+}
+
+/*
+ * The SaveLine function copies a line of the given length to Buffer (unless
+ * it is Buffer) and to LastLine.
+ */
+
+static void SaveLine(const char *Line, int Length)
+{
+    if (Line != Buffer) {
+        if (Length >= MaxBuffer) {
+            free(Buffer);
+            assert(Buffer = (char *) malloc(MaxBuffer = Length + 80));
+        }
+        memcpy(Buffer, Line, Length);
+        Buffer[Length] = '\0';
+    }
+    if (!LastLine || (int) strlen(LastLine) < Length) {
+        free(LastLine);
+        assert(LastLine = (char *) malloc((Length + 1) * sizeof(char)));
+    }
+    strcpy(LastLine, Buffer);
+}
+
+/*
+ * The fscanint function reads the next int integer from the stream f,
+ * and assigns the value through the second argmument, v, which must be
+ * a pointer. It returns 0 if end of file or an error occurs; otherwise
+ * it returns 1.
+ *
+ * It is faster than fscanf.
+ */
+
+int fscanint(FILE * f, int *v)
+{
+    MappedFile *M;
+    const char *p;
+    int val;
+    int c, sign = 1;
+
+    if ((M = FindMapped(f))) {
+        for (p = M->Pos; p < M->End && isspace((unsigned char) *p); p++);
+        if (p < M->End && (*p == '-' || *p == '+')) {
+            if (*p++ == '-')
+                sign = -1;
+        }
+        if (p == M->End || !isdigit((unsigned char) *p)) {
+            M->Pos = p;
+            return 0;
+        }
+        for (val = 0; p < M->End && isdigit((unsigned char) *p); p++)
+            val = 10 * val + (*p - '0');
+        M->Pos = p;
+        *v = sign * val;
+        return 1;
+    }
+    while (isspace(c = getc(f)));
+    if (c == '-' || c == '+') {
+        if (c == '-')
+            sign = -1;
+        if ((c = getc(f)) == EOF) {
+            ungetc(c, f);
+            return 0;
+        }
+    }
+    if (!isdigit(c)) {
+        ungetc(c, f);
+        return 0;
+    }
+    val = c - '0';
+    while (isdigit(c = getc(f)))
+        val = 10 * val + (c - '0');
+    *v = sign * val;
+    return 1;
+}
+
+/*
+ * The fscandouble function reads the next real number from the stream f,
+ * and assigns the value through v. It returns 0 if end of file or an
+ * error occurs; otherwise it returns 1.
+ *
+ * For a mapped file, a number with at most 19 significant digits (and a
+ * mantissa below 2^53) and an exponent of at most 22 in absolute value is
+ * converted by one multiplication or division of exact double values,
+ * which gives the correctly rounded result (Clinger's fast path). Any other
+ * number is converted by strtod. In both cases the value is the same as
+ * that read by fscanf with "%lf".
+ */
+
+int fscandouble(FILE * f, double *v)
+{
+    MappedFile *M;
+    const char *p;
+    char Number[64], *Token, *Rest;
+    unsigned long long Mantissa = 0;
+    int Digits = 0, AnyDigits = 0, Exponent = 0, ExponentValue = 0,
+        ExponentSign = 1, Negative = 0;
+    size_t Length;
+
+    if (!(M = FindMapped(f)))
+        return fscanf(f, "%lf", v) == 1;
+    while (M->Pos < M->End && isspace((unsigned char) *M->Pos))
+        M->Pos++;
+    p = M->Pos;
+    if (p < M->End && (*p == '-' || *p == '+'))
+        Negative = *p++ == '-';
+    for (; p < M->End && isdigit((unsigned char) *p); p++, AnyDigits = 1)
+        if ((Mantissa = 10 * Mantissa + (*p - '0')) != 0 && ++Digits > 19)
+            break;
+    if (p < M->End && *p == '.')
+        for (p++; p < M->End && isdigit((unsigned char) *p);
+             p++, AnyDigits = 1) {
+            if ((Mantissa = 10 * Mantissa + (*p - '0')) != 0 &&
+                ++Digits > 19)
+                break;
+            Exponent--;
+        }
+    if (AnyDigits && p < M->End && (*p == 'e' || *p == 'E')) {
+        p++;
+        if (p < M->End && (*p == '-' || *p == '+'))
+            ExponentSign = *p++ == '-' ? -1 : 1;
+        if (p == M->End || !isdigit((unsigned char) *p))
+            Digits = 20;
+        for (; p < M->End && isdigit((unsigned char) *p); p++)
+            if (ExponentValue < 10000)
+                ExponentValue = 10 * ExponentValue + (*p - '0');
+        Exponent += ExponentSign * ExponentValue;
+    }
+    if (AnyDigits && Digits <= 19 && Mantissa < (1ULL << 53) &&
+        (Mantissa == 0 || (Exponent >= -22 && Exponent <= 22)) &&
+        (p == M->End || !isalnum((unsigned char) *p))) {
+        *v = Mantissa == 0 ? 0.0 : Exponent >= 0 ?
+            (double) Mantissa * Power10(Exponent) :
+            (double) Mantissa / Power10(-Exponent);
+        if (Negative)
+            *v = -*v;
+        M->Pos = p;
+        return 1;
+    }
+    for (p = M->Pos; p < M->End && !isspace((unsigned char) *p); p++);
+    if ((Length = p - M->Pos) == 0)
+        return 0;
+    Token = Length < sizeof(Number) ? Number : (char *) malloc(Length + 1);
+    assert(Token);
+    memcpy(Token, M->Pos, Length);
+    Token[Length] = '\0';
+    *v = strtod(Token, &Rest);
+    M->Pos += Rest - Token;
+    if (Token != Number)
+        free(Token);
+    return Rest != Token;
+}
+
+static double Power10(int e)
+{
+    static const double P[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    return P[e];
+}
@@ -11,7 +11,9 @@ int IsBackboneCandidate(const Node * ta, const Node * tb)
 {
     Candidate *Nta;
 
-    for (Nta = ta->BackboneCandidateSet; Nta && Nta->To; Nta++)
+    if (!BackboneCandidateTable)
+        return 0;
+    for (Nta = BackboneCandidateSet(ta); Nta && Nta->To; Nta++)
         if (Nta->To == tb)
             return 1;
     return 0;
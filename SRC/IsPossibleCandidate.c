@@ -17,7 +17,8 @@ int IsPossibleCandidate(Node * From, Node * To)
     Node *Na, *Nb, *Nc, *N;
 
     if (InInitialTour(From, To) ||
-        From->SubproblemSuc == To || To->SubproblemSuc == From ||
+        (SubproblemLinkTable &&
+         (SubproblemSuc(From) == To || SubproblemSuc(To) == From)) ||
         FixedOrCommon(From, To))
         return 1;
     if (From->FixedTo2 || To->FixedTo2)
@@ -28,7 +29,7 @@ int IsPossibleCandidate(Node * From, Node * To)
         Nb = FirstNode;
         do {
             Na = Nb;
-            Nb = Na->MergeSuc[0];
+            Nb = MergeSuc(Na, 0);
         } while (Nb != FirstNode && FixedOrCommon(Na, Nb));
         if (Nb != FirstNode) {
             N = Nb;
@@ -37,11 +38,11 @@ int IsPossibleCandidate(Node * From, Node * To)
                 do {
                     Na = Nb;
                     Na->Head = Nc;
-                    Nb = Na->MergeSuc[0];
+                    Nb = MergeSuc(Na, 0);
                 } while (FixedOrCommon(Na, Nb));
                 do
                     Nc->Tail = Na;
-                while ((Nc = Nc->MergeSuc[0]) != Nb);
+                while ((Nc = MergeSuc(Nc, 0)) != Nb);
             } while (Nb != N);
         } else {
             do
@@ -17,7 +17,6 @@ int main(int argc, char *argv[])
         ParameterFileName = argv[1];
     //读取默认参数，包括问题的类型，计算精度等等
     ReadParameters();
-    MaxMatrixDimension = 10000;
     // 读取问题
     ReadProblem();
     // SubproblemSize默认值为0,表示不会对原问题进行分割
@@ -40,29 +39,37 @@ int main(int argc, char *argv[])
     }
 	// 分配所有除了节点和候选集以外的内存结构
     AllocateStructures();
-	// CreateCandidateSet()函数用来确定每个节点出度候选边	
-    CreateCandidateSet();
-    // 初始化一些统计用的变量
-    InitializeStatistics();
-    // Norm为178
-    if (Norm != 0)
-        // Norm!=0说明在前面调用的ascent()函数没有获得最优解，此时就让BestCost为正无穷
-        BestCost = PLUS_INFINITY;
-    else {
-        // 如果进入这个else语句，说明在前面调用的ascent()函数中已经获得了最优解(判断是否获得了最优解的条件就是Norm=0)
-        Optimum = BestCost = (GainType) LowerBound;
-        UpdateStatistics(Optimum, GetTime() - LastTime);
-        RecordBetterTour();
-        RecordBestTour();
-        WriteTour(OutputTourFileName, BestTour, BestCost);
-        WriteTour(TourFileName, BestTour, BestCost);
-        Runs = 0;
+    /* Continue after the last completed trial or run of a checkpoint,
+       if any */
+    if (ReadCheckpoint()) {
+        if (!ResumeTrial)
+            Run++;
+    } else {
+        // CreateCandidateSet()函数用来确定每个节点出度候选边	
+        CreateCandidateSet();
+        // 初始化一些统计用的变量
+        InitializeStatistics();
+        // Norm为178
+        if (Norm != 0)
+            // Norm!=0说明在前面调用的ascent()函数没有获得最优解，此时就让BestCost为正无穷
+            BestCost = PLUS_INFINITY;
+        else {
+            // 如果进入这个else语句，说明在前面调用的ascent()函数中已经获得了最优解(判断是否获得了最优解的条件就是Norm=0)
+            Optimum = BestCost = (GainType) LowerBound;
+            UpdateStatistics(Optimum, GetTime() - LastTime);
+            RecordBetterTour();
+            RecordBestTour();
+            WriteTour(OutputTourFileName, BestTour, BestCost);
+            WriteTour(TourFileName, BestTour, BestCost);
+            Runs = 0;
+        }
+        Run = 1;
     }
 
     /* Find a specified number (Runs) of local optima */
     // 默认情况下Runs=10
-    for (Run = 1; Run <= Runs; Run++) {
-        LastTime = GetTime();
+    for (; Run <= Runs; Run++) {
+        LastTime = GetTime() - ResumeTime;
         // FindTour()函数会使用LKH算法(里面又调用了opt交换)修正可行解，返回最优解的权重
         Cost = FindTour();    
         // MaxPopulationSize=0
@@ -110,9 +117,9 @@ int main(int argc, char *argv[])
         OldOptimum = Optimum;
         // 不会进入
         if (Cost < Optimum) {
-            if (FirstNode->InputSuc) {
+            if (InputSucTable) {
                 Node *N = FirstNode;
-                while ((N = N->InputSuc = N->Suc) != FirstNode);
+                while ((N = InputSuc(N) = N->Suc) != FirstNode);
             }
             Optimum = Cost;
             printff("*** New optimum = " GainFormat " ***\n\n", Optimum);
@@ -134,10 +141,13 @@ int main(int argc, char *argv[])
             Runs = Run;
             break;
         }
+        /* After the last run, the crossover is only made for the
+           checkpoint, so that a resumed search makes the same runs */
         //不会进入
         if (PopulationSize >= 2 &&
             (PopulationSize == MaxPopulationSize ||
-             Run >= 2 * MaxPopulationSize) && Run < Runs) {
+             Run >= 2 * MaxPopulationSize) &&
+            (Run < Runs || CheckpointFileName)) {
             Node *N;
             int Parent1, Parent2;
             Parent1 = LinearSelection(PopulationSize, 1.25);
@@ -145,6 +155,8 @@ int main(int argc, char *argv[])
                 Parent2 = LinearSelection(PopulationSize, 1.25);
             while (Parent2 == Parent1);
             ApplyCrossover(Parent1, Parent2);
+            if (!InitialSucTable)
+                InitialSucTable = (Node **) AllocateNodeTable(sizeof(Node *));
             N = FirstNode;
             do {
                 if (ProblemType != HCP && ProblemType != HPP) {
@@ -152,12 +164,14 @@ int main(int argc, char *argv[])
                     AddCandidate(N, N->Suc, d, INT_MAX);
                     AddCandidate(N->Suc, N, d, INT_MAX);
                 }
-                N = N->InitialSuc = N->Suc;
+                N = InitialSuc(N) = N->Suc;
             }
             while (N != FirstNode);
         }
         // SRandom(Seed)函数使用给定的seed生成一系列的伪随机数
         SRandom(++Seed);
+        if (Run % CheckpointInterval == 0 || Run == Runs)
+            WriteCheckpoint(0, 0);
     }
     PrintStatistics();
     return EXIT_SUCCESS;
@@ -0,0 +1,156 @@
+#include "LKH.h"
+#include <sys/mman.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+/*
+ * The functions in this file are used for allocating the large arrays
+ * whose size grows with the dimension of the problem (NodeSet, the cost
+ * matrix, the distance cache, the node tables and the arrays allocated by
+ * AllocateStructures).
+ *
+ * An array of at least LARGE_SIZE bytes is mapped directly from the system
+ * and aligned to HUGE_PAGE_SIZE. If HUGE_PAGES is YES, the kernel is
+ * advised to back the array by transparent huge pages, which reduces the
+ * number of TLB misses when the array is accessed randomly. If
+ * NUMA_INTERLEAVE is YES, the pages of the array are interleaved over all
+ * NUMA nodes of the machine. Otherwise, a page is placed on the NUMA node
+ * that first touches it (the node that runs the process).
+ *
+ * Smaller arrays, or arrays that cannot be mapped, are allocated by
+ * posix_memalign and aligned to CACHE_LINE_SIZE (e.g., each set of the
+ * distance cache occupies whole cache lines). An array allocated by
+ * LargeCalloc must be freed by LargeFree.
+ */
+
+#define LARGE_SIZE ((size_t) 1 << 21)
+#define HUGE_PAGE_SIZE ((size_t) 1 << 21)
+
+#ifndef MPOL_INTERLEAVE
+#define MPOL_INTERLEAVE 3
+#endif
+
+typedef struct LargeBlock {
+    void *Address;              /* Start of the mapped array */
+    size_t Length;              /* Number of mapped bytes */
+    struct LargeBlock *Next;    /* Next block in the list of blocks */
+} LargeBlock;
+
+static LargeBlock *Blocks = 0;
+
+static void *AlignedCalloc(size_t Bytes);
+static void Interleave(void *Address, size_t Length);
+
+/*
+ * The LargeCalloc function allocates space for Count elements of Size
+ * bytes. The space is initialized to zero.
+ */
+
+void *LargeCalloc(size_t Count, size_t Size)
+{
+    size_t Bytes = Count * Size, Length, Head;
+    char *P;
+    LargeBlock *B;
+
+    if (Bytes < LARGE_SIZE || (!HugePages && !NUMAInterleave))
+        return AlignedCalloc(Bytes);
+    Length = (Bytes + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+    if ((P = (char *) mmap(0, Length + HUGE_PAGE_SIZE,
+                           PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1,
+                           0)) == MAP_FAILED)
+        return AlignedCalloc(Bytes);
+    /* Trim the mapping to a range aligned to HUGE_PAGE_SIZE */
+    Head = (HUGE_PAGE_SIZE - (size_t) P % HUGE_PAGE_SIZE) % HUGE_PAGE_SIZE;
+    if (Head > 0)
+        munmap(P, Head);
+    munmap(P + Head + Length, HUGE_PAGE_SIZE - Head);
+    P += Head;
+#ifdef MADV_HUGEPAGE
+    if (HugePages)
+        madvise(P, Length, MADV_HUGEPAGE);
+#endif
+    if (NUMAInterleave)
+        Interleave(P, Length);
+    assert(B = (LargeBlock *) malloc(sizeof(LargeBlock)));
+    B->Address = P;
+    B->Length = Length;
+    B->Next = Blocks;
+    Blocks = B;
+    return P;
+}
+
+/*
+ * The LargeFree function frees an array allocated by LargeCalloc.
+ * Nothing happens if P is 0.
+ */
+
+void LargeFree(void *P)
+{
+    LargeBlock *B, **Prev;
+
+    if (!P)
+        return;
+    for (Prev = &Blocks; (B = *Prev); Prev = &B->Next) {
+        if (B->Address == P) {
+            munmap(B->Address, B->Length);
+            *Prev = B->Next;
+            free(B);
+            return;
+        }
+    }
+    free(P);
+}
+
+/*
+ * The AlignedCalloc function allocates Bytes bytes aligned to
+ * CACHE_LINE_SIZE. The space is initialized to zero.
+ */
+
+static void *AlignedCalloc(size_t Bytes)
+{
+    void *P;
+
+    assert(posix_memalign(&P, CACHE_LINE_SIZE, Bytes ? Bytes : 1) == 0);
+    memset(P, 0, Bytes);
+    return P;
+}
+
+/*
+ * The Interleave function sets the memory policy of a mapped range so that
+ * its pages are interleaved over the online NUMA nodes. The function has
+ * no effect if the machine has only one NUMA node or if the policy cannot
+ * be set.
+ */
+
+static void Interleave(void *Address, size_t Length)
+{
+#if defined(__linux__) && defined(SYS_mbind)
+    unsigned long Mask[16] = { 0 };
+    int MaxNode = 8 * sizeof(Mask), From, To, Nodes = 0;
+    FILE *Online;
+    char c;
+
+    if (!(Online = fopen("/sys/devices/system/node/online", "r")))
+        return;
+    while (fscanf(Online, "%d", &From) == 1) {
+        To = From;
+        if ((c = (char) fgetc(Online)) == '-') {
+            if (fscanf(Online, "%d", &To) != 1)
+                break;
+            c = (char) fgetc(Online);
+        }
+        for (; From <= To && From < MaxNode; From++, Nodes++)
+            Mask[From / (8 * sizeof(unsigned long))] |=
+                1UL << (From % (8 * sizeof(unsigned long)));
+        if (c != ',')
+            break;
+    }
+    fclose(Online);
+    if (Nodes > 1)
+        syscall(SYS_mbind, Address, Length, MPOL_INTERLEAVE, Mask,
+                MaxNode + 1, 0);
+#endif
+}
@@ -55,6 +55,9 @@ GainType LinKernighan()
         t2 = t1->OldSuc = t1->Suc;
         t1->OldPred = t1->Pred;
         t1->Rank = ++i;
+#ifdef ARRAY_TREE
+        TourArray[i] = t1;
+#endif
         Cost += (t1->SucCost = t2->PredCost = C(t1, t2)) - t1->Pi - t2->Pi;
         Hash ^= Rand[t1->Id] * Rand[t2->Id];
         t1->Cost = INT_MAX;
@@ -86,6 +89,9 @@ GainType LinKernighan()
     // 会进入
     if (S->Size < GroupSize)
         SS->Size++;
+#ifdef BALANCED_TREE
+    BuildBTree();
+#endif
     Cost /= Precision;
     //不会进入
     if (TraceLevel >= 3 || (TraceLevel == 2 && Cost < BetterCost)) {
@@ -120,7 +126,7 @@ GainType LinKernighan()
                           (Trial > BackboneTrials &&
                            (KickType == 0 || Kicks == 0)))))
                     continue;
-                G0 = C(t1, t2);
+                G0 = TOUR_COST(t1, t2);
                 // 尝试能否找到一条修正解
                 do
                     t2 = Swaps == 0 ? BestMove(t1, t2, &G0, &Gain) :
@@ -1,5 +1,5 @@
-#include "Sequence.h"
 #include "Segment.h"
+#include "Sequence.h"
 
 /*
  * The MakeKOptMove function makes a K-opt move (K >= 2) using sorting by 
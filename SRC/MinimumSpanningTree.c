@@ -26,6 +26,8 @@
   指针suc指向了这个节点的后一个节点。
   这个函数不仅可以被用来计算稠密图的最小生成树，也可以用来计算稀疏图的最小生成树。(请注意，这里的图不是以输入文件为基础，而是以候选集为基础的)
  */
+static void DenseMinimumSpanningTree(void);
+
 void MinimumSpanningTree(int Sparse)
 {
     Node *Blue;         /* 指向的是被加入到最小生成树中的最后一个节点*/
@@ -86,14 +88,40 @@ void MinimumSpanningTree(int Sparse)
         }
     }
      // 这个else只会在程序初始化和结束的时候进入
+    else if (D == D_FUNCTION && BatchableDistance() && MergeTourFiles < 2)
+        DenseMinimumSpanningTree();
     else {
         // 这张图是稠密图
+        /* When D is computed by the distance function, the distances from
+           Blue to the nodes whose cost may be lowered are computed in one
+           batch (see DistanceBatch) */
+        int Batch = D == D_FUNCTION, Count = 0, i = 0, *Dist = 0;
+        Node **To = 0;
+        ArenaMark Mark = MarkArena(&ScratchArena);
+
+        if (Batch) {
+            To = (Node **) ArenaAlloc(&ScratchArena,
+                                      Dimension * sizeof(Node *));
+            Dist = (int *) ArenaAlloc(&ScratchArena, Dimension * sizeof(int));
+        }
         // 初始化所有节点的cost为正无穷
         while ((N = N->Suc) != FirstNode)
             N->Cost = INT_MAX;
         // 循环终止条件:所有节点都出现在最小生成树中
         while ((N = Blue->Suc) != FirstNode) {
             int Min = INT_MAX;
+            if (Batch) {
+                Count = i = 0;
+                do
+                    if (!FixedOrCommon(Blue, N) &&
+                        !Blue->FixedTo2 && !N->FixedTo2 &&
+                        !Forbidden(Blue, N) &&
+                        (!c || c(Blue, N) < N->Cost))
+                        To[Count++] = N;
+                while ((N = N->Suc) != FirstNode);
+                DistanceBatch(Blue, To, Count, Dist);
+                N = Blue->Suc;
+            }
             //更新链表中除blue节点外的所有节点
             do {
                 // FixedOrCommon(a,b):判断(a,b)是否在同一条fixed edge上，或者(a,b)这条边是否被一条即将合并的路径包含
@@ -103,7 +131,11 @@ void MinimumSpanningTree(int Sparse)
                     NextBlue = N;
                     Min = INT_MIN;
                 } else {
-                    if (!Blue->FixedTo2 && !N->FixedTo2 &&
+                    if (Batch ?
+                        i < Count && To[i] == N &&
+                        (d = Dist[i++] * Precision + Blue->Pi + N->Pi) <
+                        N->Cost :
+                        !Blue->FixedTo2 && !N->FixedTo2 &&
                         !Forbidden(Blue, N) &&
                         (!c || c(Blue, N) < N->Cost) &&
                         (d = D(Blue, N)) < N->Cost) {
@@ -120,5 +152,142 @@ void MinimumSpanningTree(int Sparse)
             Follow(NextBlue, Blue);
             Blue = NextBlue;
         }
+        ReleaseArena(&ScratchArena, Mark);
+    }
+}
+
+/*
+ * The DenseMinimumSpanningTree function determines a minimum spanning tree
+ * in the complete graph when D is computed from the coordinates of the nodes
+ * (D == D_FUNCTION, BatchableDistance() returns 1, and there are no common
+ * edges of merge tours). It produces the same tree and the same node list as
+ * the dense branch of MinimumSpanningTree.
+ *
+ * The nodes not yet in the tree are kept in contiguous arrays (coordinates,
+ * Pi-values and costs) in list order. In each step the distances from Blue
+ * to all of them are computed by DistanceBatchXYZ, after which UpdateCosts
+ * lowers the costs and returns the minimum cost. The father of a node is
+ * recorded as the step in which it became Blue. A node that joins the tree
+ * leaves a hole in the arrays (its Free entry becomes 0 and its cost
+ * INT_MAX). The holes are squeezed out, preserving the order, when they
+ * outnumber the nodes.
+ *
+ * A node N with N->FixedTo2 != 0 is only connected by its fixed edges. If
+ * Blue has a fixed edge to a node not in the tree, that node joins the tree
+ * next.
+ */
+
+static int UpdateCosts(int Count, const int *Dist, int Precision,
+                       int BluePi, const int *Pi, const int *Free,
+                       int *Cost, int *DadStep, int Step);
+
+static void DenseMinimumSpanningTree()
+{
+    Node *Blue = FirstNode, *N, **Ptr, **Blues;
+    double *X, *Y, *Z;
+    int *Pi, *Cost, *Free, *DadStep, *Dist, Count = 0, Holes = 0, Step = 1;
+    int Next, Min, i, j;
+    ArenaMark Mark = MarkArena(&ScratchArena);
+
+    Ptr = (Node **) ArenaAlloc(&ScratchArena, Dimension * sizeof(Node *));
+    Blues = (Node **) ArenaAlloc(&ScratchArena,
+                                 (Dimension + 1) * sizeof(Node *));
+    X = (double *) ArenaAlloc(&ScratchArena, Dimension * sizeof(double));
+    Y = (double *) ArenaAlloc(&ScratchArena, Dimension * sizeof(double));
+    Z = (double *) ArenaAlloc(&ScratchArena, Dimension * sizeof(double));
+    Pi = (int *) ArenaAlloc(&ScratchArena, Dimension * sizeof(int));
+    Cost = (int *) ArenaAlloc(&ScratchArena, Dimension * sizeof(int));
+    Free = (int *) ArenaAlloc(&ScratchArena, Dimension * sizeof(int));
+    DadStep = (int *) ArenaAlloc(&ScratchArena, Dimension * sizeof(int));
+    Dist = (int *) ArenaAlloc(&ScratchArena, Dimension * sizeof(int));
+    for (N = FirstNode->Suc; N != FirstNode; N = N->Suc, Count++) {
+        Ptr[Count] = N;
+        X[Count] = N->X;
+        Y[Count] = N->Y;
+        Z[Count] = N->Z;
+        Pi[Count] = N->Pi;
+        Cost[Count] = N->Cost = INT_MAX;
+        Free[Count] = !N->FixedTo2;
+        DadStep[Count] = 0;
+    }
+    for (; Count > Holes; Step++) {
+        Blues[Step] = Blue;
+        if (!Blue->FixedTo2) {
+            DistanceBatchXYZ(Blue, X, Y, Z, Count, Dist);
+            Min = UpdateCosts(Count, Dist, Precision, Blue->Pi, Pi, Free,
+                              Cost, DadStep, Step);
+        } else
+            for (i = 0, Min = INT_MAX; i < Count; i++)
+                if (Cost[i] < Min)
+                    Min = Cost[i];
+        Next = -1;
+        if (Blue->FixedTo1 || Blue->FixedTo2) {
+            for (i = 0; i < Count; i++) {
+                if ((N = Ptr[i]) &&
+                    (N == Blue->FixedTo1 || N == Blue->FixedTo2)) {
+                    Cost[i] = D(Blue, N);
+                    DadStep[i] = Step;
+                    Next = i;
+                }
+            }
+        }
+        if (Next < 0)
+            for (Next = 0; !Ptr[Next] || Cost[Next] != Min; Next++);
+        N = Ptr[Next];
+        N->Cost = Cost[Next];
+        if (DadStep[Next])
+            N->Dad = Blues[DadStep[Next]];
+        Follow(N, Blue);
+        Blue = N;
+        Ptr[Next] = 0;
+        Cost[Next] = INT_MAX;
+        Free[Next] = 0;
+        if (++Holes > Count / 2) {
+            for (i = j = 0; i < Count; i++) {
+                if (!Ptr[i])
+                    continue;
+                Ptr[j] = Ptr[i];
+                X[j] = X[i];
+                Y[j] = Y[i];
+                Z[j] = Z[i];
+                Pi[j] = Pi[i];
+                Cost[j] = Cost[i];
+                Free[j] = Free[i];
+                DadStep[j++] = DadStep[i];
+            }
+            Count = j;
+            Holes = 0;
+        }
+    }
+    ReleaseArena(&ScratchArena, Mark);
+}
+
+/*
+ * The UpdateCosts function lowers the cost of each free node i to
+ * Dist[i] * Precision + BluePi + Pi[i], if that is smaller, and records Step
+ * as the step of its father. The function returns the minimum cost.
+ *
+ * The loop is branch-free so that the compiler vectorizes it. With GCC on
+ * x86-64 Linux, versions for AVX-512 and AVX2 are generated and chosen at
+ * run time.
+ */
+
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) &&\
+    defined(__linux__)
+__attribute__ ((target_clones("avx512f", "avx2", "default")))
+#endif
+static int UpdateCosts(int Count, const int *Dist, int Precision,
+                       int BluePi, const int *Pi, const int *Free,
+                       int *Cost, int *DadStep, int Step)
+{
+    int i, d, Lower, Min = INT_MAX;
+
+    for (i = 0; i < Count; i++) {
+        d = Dist[i] * Precision + BluePi + Pi[i];
+        Lower = Free[i] & (d < Cost[i]);
+        Cost[i] = Lower ? d : Cost[i];
+        DadStep[i] = Lower ? Step : DadStep[i];
+        Min = Cost[i] < Min ? Cost[i] : Min;
     }
+    return Min;
 }
@@ -0,0 +1,59 @@
+#include "LKH.h"
+
+/*
+ * The functions in this file are used for the tables that hold node data
+ * only needed for certain features (tour files, subproblem partitioning,
+ * backbone trials, coordinate conversions, node renumbering).
+ *
+ * Keeping these data out of the Node structure makes the structure smaller
+ * for all problems, which matters for very large instances. Each table is
+ * indexed by node number and is allocated only when its feature is used.
+ * The data are accessed by the macros InitialSuc, InputSuc, MergeSuc,
+ * SubproblemPred, SubproblemSuc, SubBestPred, SubBestSuc,
+ * BackboneCandidateSet, Xc, Yc, Zc, ExternalId and InternalId (see LKH.h).
+ */
+
+/*
+ * The AllocateNodeTable function allocates a table with one entry of Size
+ * bytes for each node of the problem (indexed by node number). All entries
+ * are zero.
+ *
+ * For ATSP instances the table covers all nodes of the transformed
+ * (symmetric) problem; for HPP instances it includes the extra node.
+ * The table must be freed by LargeFree.
+ */
+
+void *AllocateNodeTable(size_t Size)
+{
+    int Nodes = ProblemType == ATSP ? 2 * DimensionSaved :
+        DimensionSaved + (ProblemType == HPP);
+    return LargeCalloc((size_t) Nodes + 1, Size);
+}
+
+/*
+ * The BytesPerNode function returns the number of bytes currently used per
+ * node by the Node structure and the allocated node tables.
+ */
+
+int BytesPerNode()
+{
+    size_t Bytes = sizeof(Node);
+
+    if (InitialSucTable)
+        Bytes += sizeof(Node *);
+    if (InputSucTable)
+        Bytes += sizeof(Node *);
+    if (MergeSucTable)
+        Bytes += MergeTourFiles * sizeof(Node *);
+    if (SubproblemLinkTable)
+        Bytes += sizeof(SubproblemLinks);
+    if (BackboneCandidateTable)
+        Bytes += sizeof(Candidate *);
+    if (ConvertedCoordTable)
+        Bytes += sizeof(ConvertedCoords);
+    if (ExternalIdTable)
+        Bytes += 2 * sizeof(int);
+    if (Trig)
+        Bytes += sizeof(TrigTerms);
+    return (int) Bytes;
+}
@@ -13,6 +13,9 @@ void PrintParameters()
     printff("ASCENT_CANDIDATES = %d\n", AscentCandidates);
     printff("BACKBONE_TRIALS = %d\n", BackboneTrials);
     printff("BACKTRACKING = %s\n", Backtracking ? "YES" : "NO");
+    printff("%sBINARY_PROBLEM_FILE = %s\n",
+            BinaryProblemFileName ? "" : "# ",
+            BinaryProblemFileName ? BinaryProblemFileName : "");
     if (CandidateFiles == 0)
         printff("# CANDIDATE_FILE =\n");
     else
@@ -24,6 +27,27 @@ void PrintParameters()
             CandidateSetType == NN ? "NEAREST-NEIGHBOR" :
             CandidateSetType == QUADRANT ? "QUADRANT" : "",
             DelaunayPure ? " PURE" : "");
+    printff("%sCHECKPOINT_FILE = %s\n",
+            CheckpointFileName ? "" : "# ",
+            CheckpointFileName ? CheckpointFileName : "");
+    printff("CHECKPOINT_INTERVAL = %d\n", CheckpointInterval);
+    printff("CHECKPOINT_TRIALS = %d\n", CheckpointTrials);
+    printff("CONVERT_ONLY = %s\n", ConvertOnly ? "YES" : "NO");
+    printff("%sCOST_MATRIX_FILE = %s\n",
+            CostMatrixFileName ? "" : "# ",
+            CostMatrixFileName ? CostMatrixFileName : "");
+    printff("COST_MATRIX_WIDTH = %d\n", CostMatrixWidth);
+    if (DistanceCacheSize >= 0)
+        printff("DISTANCE_CACHE_SIZE = %d\n", DistanceCacheSize);
+    else
+        printff("# DISTANCE_CACHE_SIZE =\n");
+    if (DistanceLibraryName)
+        printff("DISTANCE_LIBRARY = %s\n", DistanceLibraryName);
+    else
+        printff("# DISTANCE_LIBRARY =\n");
+    printff("DISTANCE_LIBRARY_MEMO_SIZE = %d\n", DistanceLibraryMemoSize);
+    printff("EUC_2D_SINGLE_PRECISION = %s\n",
+            Euc2DSinglePrecision ? "YES" : "NO");
     if (Excess >= 0)
         printff("EXCESS = %g\n", Excess);
     else
@@ -36,6 +60,7 @@ void PrintParameters()
             ExtraCandidateSetType == QUADRANT ? "QUADRANT" : "");
     printff("GAIN23 = %s\n", Gain23Used ? "YES" : "NO");
     printff("GAIN_CRITERION = %s\n", GainCriterionUsed ? "YES" : "NO");
+    printff("HUGE_PAGES = %s\n", HugePages ? "YES" : "NO");
     if (InitialPeriod >= 0)
         printff("INITIAL_PERIOD = %d\n", InitialPeriod);
     else
@@ -72,14 +97,20 @@ void PrintParameters()
         printff("MAX_TRIALS = %d\n", MaxTrials);
     else
         printff("# MAX_TRIALS =\n");
+    printff("MEMORY_LIMIT = %g\n", MemoryLimit);
     if (MergeTourFiles == 0)
         printff("# MERGE_TOUR_FILE =\n");
     else
         for (i = 0; i < MergeTourFiles; i++)
             printff("MERGE_TOUR_FILE = %s\n", MergeTourFileName[i]);
     printff("MOVE_TYPE = %d\n", MoveType);
+    printff("NODE_ORDER = %s\n",
+            NodeOrder == INITIAL_TOUR_ORDER ? "INITIAL_TOUR" :
+            NodeOrder == MOORE_ORDER ? "MOORE" :
+            NodeOrder == SIERPINSKI_ORDER ? "SIERPINSKI" : "INPUT");
     printff("%sNONSEQUENTIAL_MOVE_TYPE = %d\n",
             PatchingA > 1 ? "" : "# ", NonsequentialMoveType);
+    printff("NUMA_INTERLEAVE = %s\n", NUMAInterleave ? "YES" : "NO");
     if (Optimum == MINUS_INFINITY)
         printff("# OPTIMUM =\n");
     else
@@ -103,8 +134,10 @@ void PrintParameters()
             ProblemFileName ? "" : "# ",
             ProblemFileName ? ProblemFileName : "");
     printff("RESTRICTED_SEARCH = %s\n", RestrictedSearch ? "YES" : "NO");
+    printff("RESUME = %s\n", Resume ? "YES" : "NO");
     printff("RUNS = %d\n", Runs);
     printff("SEED = %u\n", Seed);
+    printff("SEGMENT_TUNING_TRIALS = %d\n", SegmentTuningTrials);
     printff("STOP_AT_OPTIMUM = %s\n", StopAtOptimum ? "YES" : "NO");
     printff("SUBGRADIENT = %s\n", Subgradient ? "YES" : "NO");
     if (SubproblemSize == 0)
@@ -133,5 +166,13 @@ void PrintParameters()
         printff("TIME_LIMIT = %0.1f\n", TimeLimit);
     printff("%sTOUR_FILE = %s\n",
             TourFileName ? "" : "# ", TourFileName ? TourFileName : "");
-    printff("TRACE_LEVEL = %d\n\n", TraceLevel);
+    printff("TRACE_LEVEL = %d\n", TraceLevel);
+    if (TreeType == -1)
+        printff("# TREE_TYPE =\n\n");
+    else
+        printff("TREE_TYPE = %s\n\n",
+                TreeType == ARRAY_TOUR ? "ARRAY" :
+                TreeType == ONE_LEVEL_LIST ? "ONE-LEVEL" :
+                TreeType == TWO_LEVEL_LIST ? "TWO-LEVEL" :
+                TreeType == THREE_LEVEL_LIST ? "THREE-LEVEL" : "BALANCED");
 }
@@ -15,6 +15,8 @@
  * pseudo-random numbers.  
  */
 
+#include <stdio.h>
+
 unsigned Random(void);
 
 /*
@@ -22,6 +24,16 @@ unsigned Random(void);
  */
 void SRandom(unsigned Seed);
 
+/*
+ * The WriteRandomState function writes the state of the generator to a
+ * file (see WriteCheckpoint). The ReadRandomState function restores a
+ * state written by WriteRandomState, and returns 1 if it could be read;
+ * otherwise 0.
+ */
+void WriteRandomState(FILE * f);
+int ReadRandomState(FILE * f);
+int ReadInputBytes(FILE * f, void *v, size_t Size);
+
 #undef STDLIB_RANDOM
 /* #define STDLIB_RANDOM */
 
@@ -37,6 +49,17 @@ void SRandom(unsigned Seed)
     srand(Seed);
 }
 
+/* The state of rand cannot be saved */
+
+void WriteRandomState(FILE * f)
+{
+}
+
+int ReadRandomState(FILE * f)
+{
+    return 1;
+}
+
 #else
 
 #include <limits.h>
@@ -79,4 +102,21 @@ void SRandom(unsigned Seed)
         Random();
 }
 
+void WriteRandomState(FILE * f)
+{
+    if (!initialized)
+        SRandom(7913);
+    fwrite(&a, sizeof(int), 1, f);
+    fwrite(&b, sizeof(int), 1, f);
+    fwrite(arr, sizeof(int), 55, f);
+}
+
+int ReadRandomState(FILE * f)
+{
+    initialized = 1;
+    return ReadInputBytes(f, &a, sizeof(int)) && a >= 0 && a < 55 &&
+        ReadInputBytes(f, &b, sizeof(int)) && b >= 0 && b < 55 &&
+        ReadInputBytes(f, arr, sizeof(arr));
+}
+
 #endif
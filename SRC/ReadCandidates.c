@@ -12,6 +12,10 @@
  * candidate edges. For each candidate edge its end node number and 
  * alpha-value are given.
  *
+ * A file that starts with BINARY_CANDIDATE_HEADER is read in binary (see
+ * WriteCandidates.c), one block for the numbers of each node and one for
+ * its candidate edges.
+ *
  * The parameter MaxCandidates specifies the maximum number of candidate edges 
  * allowed for each node.
  *
@@ -20,51 +24,59 @@
  * The function is called from the CreateCandidateSet function. 
  */
 
+static void ReadBinaryCandidates(FILE * CandidateFile, char *FileName,
+                                 int Dimension);
+
 int ReadCandidates(int MaxCandidates)
 {
     FILE *CandidateFile = 0;
     Node *From, *To;
-    int Dimension, i, f, Id, Alpha, Count;
+    int Dimension, i, f, Id, Alpha, Count, Binary;
 
     if (CandidateFiles == 0 ||
         (CandidateFiles == 1 &&
-         !(CandidateFile = fopen(CandidateFileName[0], "r"))))
+         !(CandidateFile = OpenInputFile(CandidateFileName[0]))))
         return 0;
     Dimension = ProblemType != ATSP ? DimensionSaved : 2 * DimensionSaved;
     for (f = 0; f < CandidateFiles; f++) {
         if (CandidateFiles >= 2 &&
-            !(CandidateFile = fopen(CandidateFileName[f], "r")))
+            !(CandidateFile = OpenInputFile(CandidateFileName[f])))
             eprintf("Cannot open CANDIDATE_FILE: \"%s\"",
                     CandidateFileName[f]);
         if (TraceLevel >= 1)
             printff("Reading CANDIDATE_FILE: \"%s\" ... ",
                     CandidateFileName[f]);
-        fscanint(CandidateFile, &i);
+        Binary = ReadInputHeader(CandidateFile, BINARY_CANDIDATE_HEADER);
+        ScanInt(CandidateFile, Binary, &i);
         if (i != Dimension)
             eprintf("CANDIDATE_FILE \"%s\" does not match problem",
                     CandidateFileName[f]);
-        while (fscanint(CandidateFile, &Id) == 1 && Id != -1) {
-            assert(Id >= 1 && Id <= Dimension);
-            From = &NodeSet[Id];
-            fscanint(CandidateFile, &Id);
-            assert(Id >= 0 && Id <= Dimension);
-            if (Id > 0)
-                From->Dad = &NodeSet[Id];
-            assert(From != From->Dad);
-            fscanint(CandidateFile, &Count);
-            assert(Count >= 0 && Count < Dimension);
-            if (!From->CandidateSet)
-                assert(From->CandidateSet =
-                       (Candidate *) calloc(Count + 1, sizeof(Candidate)));
-            for (i = 0; i < Count; i++) {
-                fscanint(CandidateFile, &Id);
+        if (Binary)
+            ReadBinaryCandidates(CandidateFile, CandidateFileName[f],
+                                 Dimension);
+        else
+            while (fscanint(CandidateFile, &Id) == 1 && Id != -1) {
                 assert(Id >= 1 && Id <= Dimension);
-                To = &NodeSet[Id];
-                fscanint(CandidateFile, &Alpha);
-                AddCandidate(From, To, D(From, To), Alpha);
+                From = &NodeSet[InternalId(Id)];
+                fscanint(CandidateFile, &Id);
+                assert(Id >= 0 && Id <= Dimension);
+                if (Id > 0)
+                    From->Dad = &NodeSet[InternalId(Id)];
+                assert(From != From->Dad);
+                fscanint(CandidateFile, &Count);
+                assert(Count >= 0 && Count < Dimension);
+                if (!From->CandidateSet)
+                    assert(From->CandidateSet =
+                           (Candidate *) calloc(Count + 1, sizeof(Candidate)));
+                for (i = 0; i < Count; i++) {
+                    fscanint(CandidateFile, &Id);
+                    assert(Id >= 1 && Id <= Dimension);
+                    To = &NodeSet[InternalId(Id)];
+                    fscanint(CandidateFile, &Alpha);
+                    AddCandidate(From, To, D(From, To), Alpha);
+                }
             }
-        }
-        fclose(CandidateFile);
+        CloseInputFile(CandidateFile);
         if (TraceLevel >= 1)
             printff("done\n");
     }
@@ -73,3 +85,49 @@ int ReadCandidates(int MaxCandidates)
         TrimCandidateSet(MaxCandidates);
     return 1;
 }
+
+/*
+ * The ReadBinaryCandidates function reads the candidate edges of a binary
+ * CANDIDATE_FILE. For each node the node number, the dad's number and the
+ * number of candidate edges are read as one block, followed by one block
+ * with the end node numbers and alpha-values of the candidate edges.
+ */
+
+static void ReadBinaryCandidates(FILE * CandidateFile, char *FileName,
+                                 int Dimension)
+{
+    Node *From, *To;
+    int i, Row[3], MaxCount = 0, *Edges = 0;
+
+    while (ReadInputBytes(CandidateFile, Row, sizeof(int)) &&
+           Row[0] != -1) {
+        if (!ReadInputBytes(CandidateFile, Row + 1, 2 * sizeof(int)))
+            eprintf("CANDIDATE_FILE \"%s\": unexpected end of file",
+                    FileName);
+        assert(Row[0] >= 1 && Row[0] <= Dimension);
+        From = &NodeSet[InternalId(Row[0])];
+        assert(Row[1] >= 0 && Row[1] <= Dimension);
+        if (Row[1] > 0)
+            From->Dad = &NodeSet[InternalId(Row[1])];
+        assert(From != From->Dad);
+        assert(Row[2] >= 0 && Row[2] < Dimension);
+        if (Row[2] > MaxCount) {
+            free(Edges);
+            assert(Edges =
+                   (int *) malloc(2 * (MaxCount = Row[2]) * sizeof(int)));
+        }
+        if (Row[2] > 0 &&
+            !ReadInputBytes(CandidateFile, Edges, 2 * Row[2] * sizeof(int)))
+            eprintf("CANDIDATE_FILE \"%s\": unexpected end of file",
+                    FileName);
+        if (!From->CandidateSet)
+            assert(From->CandidateSet =
+                   (Candidate *) calloc(Row[2] + 1, sizeof(Candidate)));
+        for (i = 0; i < Row[2]; i++) {
+            assert(Edges[2 * i] >= 1 && Edges[2 * i] <= Dimension);
+            To = &NodeSet[InternalId(Edges[2 * i])];
+            AddCandidate(From, To, D(From, To), Edges[2 * i + 1]);
+        }
+    }
+    free(Edges);
+}
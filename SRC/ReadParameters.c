@@ -100,6 +100,15 @@
  * move in a sequence of moves (where K = MOVE_TYPE). 
  * Default: NO.
  *
+ * BINARY_PROBLEM_FILE = <string>
+ * Specifies the name of a binary version of the problem file. If the file
+ * exists and is up to date with PROBLEM_FILE (same size and modification
+ * time), the problem is read from it instead of from PROBLEM_FILE, which
+ * is much faster for large problems. Otherwise, PROBLEM_FILE is read and
+ * the binary file is written. If PROBLEM_FILE is not specified, the binary
+ * file is used as it is. The file holds the node coordinates and the
+ * cost matrix in the native byte order (see ReadProblem.c).
+ *
  * CANDIDATE_FILE = <string>
  * Specifies the name of a file to which the candidate sets are to be 
  * written. If, however, the file already exists, the candidate edges are 
@@ -109,6 +118,9 @@
  * (0, if the node has no dad), the number of candidate edges emanating 
  * from the node, followed by the candidate edges. For each candidate edge 
  * its end node number and alpha-value are given.
+ * If the file name ends with ".bin", the file is written in a binary
+ * format, which is much faster to read. When a file is read, the binary
+ * format is recognized by its header.
  * It is possible to give more than one CANDIDATE_FILE specification. In this
  * case the given files are read and the union of their candidate edges is
  * used as candidate sets.
@@ -122,15 +134,91 @@
  * edges of the Delaunay graph are used as candidates. 
  * Default: ALPHA.
  *
+ * CHECKPOINT_FILE = <string>
+ * Specifies the name of a binary file to which the state of the search is
+ * written after every CHECKPOINT_INTERVAL runs, after the last run, and,
+ * if CHECKPOINT_TRIALS is positive, after every CHECKPOINT_TRIALS trials of
+ * a run. The state includes the best tours, the Pi-values and candidate
+ * sets, the population of the genetic algorithm, the state of the random
+ * number generator, and the statistics. If RESUME is YES, the search is
+ * resumed from the file (see RESUME).
+ *
+ * CHECKPOINT_INTERVAL = <integer>
+ * Specifies the number of runs between checkpoints.
+ * Default: 1.
+ *
+ * CHECKPOINT_TRIALS = <integer>
+ * Specifies the number of trials between checkpoints within a run. No
+ * checkpoint is written while the segment sizes are being tuned (see
+ * SEGMENT_TUNING_TRIALS) or backbones are being recorded (see
+ * BACKBONE_TRIALS). The value 0 signifies that checkpoints are only
+ * written between runs.
+ * Default: 0.
+ *
  * COMMENT <string>
  * A comment.
  *
+ * CONVERT_ONLY = { YES | NO }
+ * Specifies whether the program should stop after PROBLEM_FILE has been
+ * converted to BINARY_PROBLEM_FILE. The conversion is done even if the
+ * binary file is up to date. Both files must be specified.
+ * Default: NO.
+ *
+ * COST_MATRIX_FILE = <string>
+ * Specifies the name of a binary file for the cost matrix of a symmetric
+ * problem. If the file does not exist, the cost matrix (read from the 
+ * EDGE_WEIGHT_SECTION, or computed from the node coordinates) is written
+ * to it. If the file exists, it is mapped into memory and used as the 
+ * cost matrix. The EDGE_WEIGHT_SECTION may then be omitted from the 
+ * problem file. The file must have been written for the same problem 
+ * (and on a machine with the same byte order).
+ *
+ * COST_MATRIX_WIDTH = { 8 | 16 | 32 }
+ * Specifies the number of bits used for each entry of a symmetric cost
+ * matrix. With 8 or 16 bits the matrix takes a quarter or a half of the
+ * memory. The entries are then stored relative to the smallest weight,
+ * and the precision is applied each time an entry is read. If some weight
+ * does not fit, more bits are used.
+ * Default: 32.
+ *
+ * DISTANCE_CACHE_SIZE = <integer>
+ * Specifies the number of distances that can be kept in the cache used 
+ * for problems without a cost matrix. The cache is 4-way set-associative,
+ * and the number is rounded up such that the number of sets is a power 
+ * of 2. The value 0 signifies that no cache is used. The number of hits
+ * and misses is reported together with the statistics of the runs.
+ * Default: 2 * DIMENSION.
+ *
+ * DISTANCE_LIBRARY = <string>
+ * Specifies the name of a shared library that computes the distances
+ * when the EDGE_WEIGHT_TYPE is SPECIAL. The library must export the
+ * function LKH_DistanceBatch and may export LKH_DistanceInit (see
+ * DistanceLibrary.c). Each distance obtained from the library is kept in
+ * memory, so that it is computed only once. The library cannot be used
+ * with NEAREST-NEIGHBOR or QUADRANT candidate sets, or with K-MEANS
+ * partitioning.
+ * Default: none.
+ *
+ * DISTANCE_LIBRARY_MEMO_SIZE = <integer>
+ * Specifies the maximum number of distances obtained from the
+ * DISTANCE_LIBRARY that are kept in memory (0: no limit).
+ * Default: 0.
+ *
  * # <string>
  * A comment.
  *
  * EOF
  * Terminates the input data. The entry is optional.
  *
+ * EUC_2D_SINGLE_PRECISION = { YES | NO }
+ * Specifies whether EUC_2D distances are computed with a single-precision
+ * square root when all node coordinates are integers less than 2^20 in
+ * absolute value. The rounded result is verified in integer arithmetic,
+ * and computed in double precision if the verification fails, so the
+ * distances are the same as with NO. Whether it is faster depends on the
+ * processor.
+ * Default: NO.
+ *
  * EXCESS = <real>
  * The maximum alpha-value allowed for any candidate edge is set to 
  * EXCESS times the absolute value of the lower bound of a solution 
@@ -158,6 +246,12 @@
  * Specifies whether Lin and Kernighan's gain criterion is used.
  * Default: YES.
  *
+ * HUGE_PAGES = { YES | NO }
+ * Specifies whether the large arrays (nodes, cost matrix, distance cache
+ * and the like) are backed by transparent huge pages, if the operating
+ * system supports them.
+ * Default: YES.
+ *
  * INITIAL_PERIOD = <integer>
  * The length of the first period in the ascent.
  * Default: value of DIMENSION/2 (but at least 100). 
@@ -226,6 +320,17 @@
  * The maximum number of trials in each run.
  * Default: number of nodes (DIMENSION, given in the problem file).
  * 
+ * MEMORY_LIMIT = <real>
+ * Specifies the number of megabytes that may be used for a cost matrix
+ * computed from node coordinates. The matrix is only computed if it fits 
+ * with 32-bit entries (plus a copy with 16-bit entries if 
+ * COST_MATRIX_WIDTH is 8 or 16, used while it is compressed), and the
+ * distance function is expensive to evaluate (i.e., for all other types
+ * than EUC_2D, MAX_2D, MAN_2D, and CEIL_2D). Otherwise distances are
+ * computed when needed, and cached. The limit also determines the maximum dimension of an HPP 
+ * instance.
+ * Default: 200.
+ *
  * MERGE_TOUR_FILE = <string>
  * Specifies the name of a tour to be merged. The edges of the tour are 
  * added to the candidate sets.
@@ -236,6 +341,15 @@
  * A value K >= 2 signifies that a sequential K-opt move is used.
  * Default: 5.
  *
+ * NODE_ORDER = { INPUT | INITIAL_TOUR | MOORE | SIERPINSKI }
+ * Specifies the order in which the nodes are stored. INPUT means the order
+ * of the problem file. Otherwise the nodes are renumbered before the 
+ * candidate sets are created, either along the tour given by 
+ * INITIAL_TOUR_FILE, or along a Moore or Sierpinski space-filling curve. 
+ * Renumbering makes memory accesses more local, but does not change the 
+ * node numbers in files. Not possible for ATSP, HPP and EXPLICIT instances.
+ * Default: INPUT.
+ *
  * NONSEQUENTIAL_MOVE_TYPE = <integer>
  * Specifies the nonsequential move type to be used. A value K >= 4 
  * signifies that attempts are made to improve a tour by nonsequential 
@@ -243,6 +357,12 @@
  * on the specifications of PATCHING_C and PATCHING_A. 
  * Default: value of (MOVE_TYPE + PATCHING_C + PATCHING_A - 1).
  *
+ * NUMA_INTERLEAVE = { YES | NO }
+ * Specifies whether the pages of the large arrays are interleaved over
+ * all NUMA nodes of the machine. If NO, each page is placed on the NUMA
+ * node that first touches it.
+ * Default: NO.
+ *
  * OUTPUT_TOUR_FILE = <string>
  * Specifies the name of a file where the best tour is to be written.
  * Each time a trial has produced a new best tour, the tour is written 
@@ -286,6 +406,9 @@
  *       <integer> <integer>
  * where the first integer is a node number, and the second integer is 
  * the Pi-value associated with the node.
+ * If the file name ends with ".bin", the file is written in a binary
+ * format, which is much faster to read. When a file is read, the binary
+ * format is recognized by its header.
  * The file name "0" represents a file with all Pi-values equal to zero.
  *
  * POPULATION_SIZE = <integer>
@@ -305,6 +428,16 @@
  * to the minimum spanning 1-tree.     
  * Default: YES. 
  * 
+ * RESUME = { YES | NO }
+ * Specifies whether the search is resumed from CHECKPOINT_FILE. If the
+ * file exists, the state of the search is read from it, the ascent is
+ * skipped, and the search continues after the last trial or run of the
+ * checkpoint, exactly as if the program had not been stopped. If the
+ * file does not exist, the search starts from the beginning. The file must
+ * have been written for the same problem and parameters (except RUNS,
+ * which may be increased), and on a machine with the same byte order.
+ * Default: NO.
+ *
  * RUNS = <integer>
  * The total number of runs. 
  * Default: 10.
@@ -314,6 +447,14 @@
  * seed is derived from the system clock.
  * Default: 1.
  *
+ * SEGMENT_TUNING_TRIALS = <integer>
+ * Specifies the number of trials during which the lengths of the 2-opt
+ * moves are sampled in order to tune the segment sizes of the two-level 
+ * and three-level tree representations. After these trials the segments
+ * are re-partitioned into the sizes that minimize the estimated cost of 
+ * the sampled moves. The value 0 signifies that the sizes are not tuned.
+ * Default: 0.
+ *
  * STOP_AT_OPTIMUM = { YES | NO }
  * Specifies whether a run is stopped, if the tour length becomes equal 
  * to OPTIMUM.
@@ -382,6 +523,15 @@
  * the value is the more information is given.
  * Default: 1. 
  *
+ * TREE_TYPE = { ARRAY | ONE-LEVEL | TWO-LEVEL | THREE-LEVEL | BALANCED }
+ * Specifies the tour representation. ARRAY specifies the array 
+ * representation, ONE-LEVEL the doubly linked list representation, 
+ * TWO-LEVEL the two-level tree representation, THREE-LEVEL the 
+ * three-level tree representation, and BALANCED the balanced tree 
+ * representation.
+ * Default: ARRAY if DIMENSION <= 5000, TWO-LEVEL if 
+ * DIMENSION <= 1000000, otherwise THREE-LEVEL.
+ *
  * List of abbreviations
  * ---------------------
  *
@@ -390,6 +540,8 @@
  *
  *     Value        Abbreviation
  *     ALPHA             A
+ *     ARRAY             A
+ *     BALANCED          B
  *     BORDERS           B
  *     BORUVKA           B
  *     COMPRESSED        C
@@ -402,6 +554,7 @@
  *     MOORE             M
  *     NEAREST-NEIGHBOR  N
  *     NO                N
+ *     ONE-LEVEL         O
  *     PURE              P
  *     QUADRANT          Q
  *     QUICK-BORUVKA     Q
@@ -409,6 +562,8 @@
  *     ROHE              R
  *     SIERPINSKI        S
  *     SYMMETRIC         S
+ *     THREE-LEVEL       TH
+ *     TWO-LEVEL         TW
  *     WALK              W
  *     YES               Y    
  */
@@ -426,22 +581,31 @@ void ReadParameters()
     unsigned int i;
 
     ProblemFileName = PiFileName = InputTourFileName =
-        OutputTourFileName = TourFileName = 0;
+        OutputTourFileName = TourFileName = CostMatrixFileName =
+        DistanceLibraryName = BinaryProblemFileName = CheckpointFileName = 0;
     CandidateFiles = MergeTourFiles = 0;
     AscentCandidates = 50;
     BackboneTrials = 0;
     Backtracking = 0;
     CandidateSetSymmetric = 0;
     CandidateSetType = ALPHA;
+    CheckpointInterval = 1;
+    CheckpointTrials = 0;
+    ConvertOnly = 0;
+    CostMatrixWidth = 32;
     Crossover = ERXT;
     DelaunayPartitioning = 0;
     DelaunayPure = 0;
+    DistanceCacheSize = -1;
+    DistanceLibraryMemoSize = 0;
+    Euc2DSinglePrecision = 0;
     Excess = -1;
     ExtraCandidates = 0;
     ExtraCandidateSetSymmetric = 0;
     ExtraCandidateSetType = QUADRANT;
     Gain23Used = 1;
     GainCriterionUsed = 1;
+    HugePages = 1;
     InitialPeriod = -1;
     InitialStepSize = 0;
     InitialTourAlgorithm = WALK;
@@ -456,9 +620,12 @@ void ReadParameters()
     MaxPopulationSize = 0;
     MaxSwaps = -1;
     MaxTrials = -1;
+    MemoryLimit = 200;
     MoorePartitioning = 0;
     MoveType = 5;
+    NodeOrder = INPUT_ORDER;
     NonsequentialMoveType = -1;
+    NUMAInterleave = 0;
     Optimum = MINUS_INFINITY;
     PatchingA = 1;
     PatchingC = 0;
@@ -468,9 +635,11 @@ void ReadParameters()
     PatchingCRestricted = 0;
     Precision = 100;
     RestrictedSearch = 1;
+    Resume = 0;
     RohePartitioning = 0;
     Runs = 0;
     Seed = 1;
+    SegmentTuningTrials = 0;
     SierpinskiPartitioning = 0;
     StopAtOptimum = 1;
     Subgradient = 1;
@@ -481,6 +650,7 @@ void ReadParameters()
     SubsequentPatching = 1;
     TimeLimit = DBL_MAX;
     TraceLevel = 1;
+    TreeType = -1;
 
     if (ParameterFileName) {
         if (!(ParameterFile = fopen(ParameterFileName, "r")))
@@ -525,6 +695,9 @@ void ReadParameters()
         } else if (!strcmp(Keyword, "BACKTRACKING")) {
             if (!ReadYesOrNo(&Backtracking))
                 eprintf("BACKTRACKING: YES or NO expected");
+        } else if (!strcmp(Keyword, "BINARY_PROBLEM_FILE")) {
+            if (!(BinaryProblemFileName = GetFileName(0)))
+                eprintf("BINARY_PROBLEM_FILE: string expected");
         } else if (!strcmp(Keyword, "CANDIDATE_FILE")) {
             if (!(Name = GetFileName(0)))
                 eprintf("CANDIDATE_FILE: string expected");
@@ -574,11 +747,59 @@ void ReadParameters()
                     DelaunayPure = 1;
                 }
             }
+        } else if (!strcmp(Keyword, "CHECKPOINT_FILE")) {
+            if (!(CheckpointFileName = GetFileName(0)))
+                eprintf("CHECKPOINT_FILE: string expected");
+        } else if (!strcmp(Keyword, "CHECKPOINT_INTERVAL")) {
+            if (!(Token = strtok(0, Delimiters)) ||
+                !sscanf(Token, "%d", &CheckpointInterval))
+                eprintf("CHECKPOINT_INTERVAL: integer expected");
+            if (CheckpointInterval <= 0)
+                eprintf("CHECKPOINT_INTERVAL: positive integer expected");
+        } else if (!strcmp(Keyword, "CHECKPOINT_TRIALS")) {
+            if (!(Token = strtok(0, Delimiters)) ||
+                !sscanf(Token, "%d", &CheckpointTrials))
+                eprintf("CHECKPOINT_TRIALS: integer expected");
+            if (CheckpointTrials < 0)
+                eprintf("CHECKPOINT_TRIALS: non-negative integer expected");
         } else if (!strcmp(Keyword, "COMMENT"))
             continue;
-        else if (!strcmp(Keyword, "EOF"))
+        else if (!strcmp(Keyword, "CONVERT_ONLY")) {
+            if (!ReadYesOrNo(&ConvertOnly))
+                eprintf("CONVERT_ONLY: YES or NO expected");
+        } else if (!strcmp(Keyword, "COST_MATRIX_FILE")) {
+            if (!(CostMatrixFileName = GetFileName(0)))
+                eprintf("COST_MATRIX_FILE: string expected");
+        } else if (!strcmp(Keyword, "COST_MATRIX_WIDTH")) {
+            if (!(Token = strtok(0, Delimiters)) ||
+                !sscanf(Token, "%d", &CostMatrixWidth))
+                eprintf("COST_MATRIX_WIDTH: integer expected");
+            if (CostMatrixWidth != 8 && CostMatrixWidth != 16 &&
+                CostMatrixWidth != 32)
+                eprintf("COST_MATRIX_WIDTH: 8, 16, or 32 expected");
+        } else if (!strcmp(Keyword, "DISTANCE_CACHE_SIZE")) {
+            if (!(Token = strtok(0, Delimiters)) ||
+                !sscanf(Token, "%d", &DistanceCacheSize))
+                eprintf("DISTANCE_CACHE_SIZE: integer expected");
+            if (DistanceCacheSize < 0)
+                eprintf("DISTANCE_CACHE_SIZE: "
+                        "non-negative integer expected");
+        } else if (!strcmp(Keyword, "DISTANCE_LIBRARY")) {
+            if (!(DistanceLibraryName = GetFileName(0)))
+                eprintf("DISTANCE_LIBRARY: string expected");
+        } else if (!strcmp(Keyword, "DISTANCE_LIBRARY_MEMO_SIZE")) {
+            if (!(Token = strtok(0, Delimiters)) ||
+                !sscanf(Token, "%d", &DistanceLibraryMemoSize))
+                eprintf("DISTANCE_LIBRARY_MEMO_SIZE: integer expected");
+            if (DistanceLibraryMemoSize < 0)
+                eprintf("DISTANCE_LIBRARY_MEMO_SIZE: "
+                        "non-negative integer expected");
+        } else if (!strcmp(Keyword, "EOF"))
             break;
-        else if (!strcmp(Keyword, "EXCESS")) {
+        else if (!strcmp(Keyword, "EUC_2D_SINGLE_PRECISION")) {
+            if (!ReadYesOrNo(&Euc2DSinglePrecision))
+                eprintf("EUC_2D_SINGLE_PRECISION: YES or NO expected");
+        } else if (!strcmp(Keyword, "EXCESS")) {
             if (!(Token = strtok(0, Delimiters)) ||
                 !sscanf(Token, "%lf", &Excess))
                 eprintf("EXCESS: real expected");
@@ -617,6 +838,9 @@ void ReadParameters()
         } else if (!strcmp(Keyword, "GAIN_CRITERION")) {
             if (!ReadYesOrNo(&GainCriterionUsed))
                 eprintf("GAIN_CRITERION: YES or NO expected");
+        } else if (!strcmp(Keyword, "HUGE_PAGES")) {
+            if (!ReadYesOrNo(&HugePages))
+                eprintf("HUGE_PAGES: YES or NO expected");
         } else if (!strcmp(Keyword, "INITIAL_PERIOD")) {
             if (!(Token = strtok(0, Delimiters)) ||
                 !sscanf(Token, "%d", &InitialPeriod))
@@ -711,6 +935,12 @@ void ReadParameters()
                 eprintf("MAX_TRIALS: integer expected");
             if (MaxTrials < 0)
                 eprintf("MAX_TRIALS: non-negative integer expected");
+        } else if (!strcmp(Keyword, "MEMORY_LIMIT")) {
+            if (!(Token = strtok(0, Delimiters)) ||
+                !sscanf(Token, "%lf", &MemoryLimit))
+                eprintf("MEMORY_LIMIT: real expected");
+            if (MemoryLimit < 0)
+                eprintf("MEMORY_LIMIT: non-negative real expected");
         } else if (!strcmp(Keyword, "MERGE_TOUR_FILE")) {
             if (!(Name = GetFileName(0)))
                 eprintf("MERGE_TOUR_FILE: string expected");
@@ -737,12 +967,32 @@ void ReadParameters()
                 eprintf("MOVE_TYPE: integer expected");
             if (MoveType < 2)
                 eprintf("MOVE_TYPE: >= 2 expected");
+        } else if (!strcmp(Keyword, "NODE_ORDER")) {
+            if (!(Token = strtok(0, Delimiters)))
+                eprintf("NODE_ORDER: "
+                        "INPUT, INITIAL_TOUR, MOORE or SIERPINSKI expected");
+            for (i = 0; i < strlen(Token); i++)
+                Token[i] = (char) toupper(Token[i]);
+            if (!strncmp(Token, "INPUT", strlen(Token)))
+                NodeOrder = INPUT_ORDER;
+            else if (!strncmp(Token, "INITIAL_TOUR", strlen(Token)))
+                NodeOrder = INITIAL_TOUR_ORDER;
+            else if (!strncmp(Token, "MOORE", strlen(Token)))
+                NodeOrder = MOORE_ORDER;
+            else if (!strncmp(Token, "SIERPINSKI", strlen(Token)))
+                NodeOrder = SIERPINSKI_ORDER;
+            else
+                eprintf("NODE_ORDER: "
+                        "INPUT, INITIAL_TOUR, MOORE or SIERPINSKI expected");
         } else if (!strcmp(Keyword, "NONSEQUENTIAL_MOVE_TYPE")) {
             if (!(Token = strtok(0, Delimiters)) ||
                 !sscanf(Token, "%d", &NonsequentialMoveType))
                 eprintf("NONSEQUENTIAL_MOVE_TYPE: integer expected");
             if (NonsequentialMoveType < 4)
                 eprintf("NONSEQUENTIAL_MOVE_TYPE: >= 4 expected");
+        } else if (!strcmp(Keyword, "NUMA_INTERLEAVE")) {
+            if (!ReadYesOrNo(&NUMAInterleave))
+                eprintf("NUMA_INTERLEAVE: YES or NO expected");
         } else if (!strcmp(Keyword, "OPTIMUM")) {
             if (!(Token = strtok(0, Delimiters)) ||
                 !sscanf(Token, GainInputFormat, &Optimum))
@@ -801,6 +1051,9 @@ void ReadParameters()
         } else if (!strcmp(Keyword, "RESTRICTED_SEARCH")) {
             if (!ReadYesOrNo(&RestrictedSearch))
                 eprintf("RESTRICTED_SEARCH: YES or NO expected");
+        } else if (!strcmp(Keyword, "RESUME")) {
+            if (!ReadYesOrNo(&Resume))
+                eprintf("RESUME: YES or NO expected");
         } else if (!strcmp(Keyword, "RUNS")) {
             if (!(Token = strtok(0, Delimiters)) ||
                 !sscanf(Token, "%d", &Runs))
@@ -811,6 +1064,13 @@ void ReadParameters()
             if (!(Token = strtok(0, Delimiters)) ||
                 !sscanf(Token, "%u", &Seed))
                 eprintf("SEED: integer expected");
+        } else if (!strcmp(Keyword, "SEGMENT_TUNING_TRIALS")) {
+            if (!(Token = strtok(0, Delimiters)) ||
+                !sscanf(Token, "%d", &SegmentTuningTrials))
+                eprintf("SEGMENT_TUNING_TRIALS: integer expected");
+            if (SegmentTuningTrials < 0)
+                eprintf("SEGMENT_TUNING_TRIALS: "
+                        "non-negative integer expected");
         } else if (!strcmp(Keyword, "STOP_AT_OPTIMUM")) {
             if (!ReadYesOrNo(&StopAtOptimum))
                 eprintf("STOP_AT_OPTIMUM: YES or NO expected");
@@ -887,13 +1147,39 @@ void ReadParameters()
             if (!(Token = strtok(0, Delimiters)) ||
                 !sscanf(Token, "%d", &TraceLevel))
                 eprintf("TRACE_LEVEL: integer expected");
+        } else if (!strcmp(Keyword, "TREE_TYPE")) {
+            if (!(Token = strtok(0, Delimiters)))
+                eprintf("TREE_TYPE: "
+                        "ARRAY, ONE-LEVEL, TWO-LEVEL, THREE-LEVEL, "
+                        "or BALANCED expected");
+            for (i = 0; i < strlen(Token); i++)
+                Token[i] = (char) toupper(Token[i]);
+            if (!strncmp(Token, "ARRAY", strlen(Token)))
+                TreeType = ARRAY_TOUR;
+            else if (!strncmp(Token, "ONE-LEVEL", strlen(Token)))
+                TreeType = ONE_LEVEL_LIST;
+            else if (!strncmp(Token, "TWO-LEVEL", max(strlen(Token), 2)))
+                TreeType = TWO_LEVEL_LIST;
+            else if (!strncmp(Token, "THREE-LEVEL", max(strlen(Token), 2)))
+                TreeType = THREE_LEVEL_LIST;
+            else if (!strncmp(Token, "BALANCED", strlen(Token)))
+                TreeType = BALANCED_TREE_TOUR;
+            else
+                eprintf("TREE_TYPE: "
+                        "ARRAY, ONE-LEVEL, TWO-LEVEL, THREE-LEVEL, "
+                        "or BALANCED expected");
         } else
             eprintf("Unknown keyword: %s", Keyword);
         if ((Token = strtok(0, Delimiters)) && Token[0] != '#')
             eprintf("Junk at end of line: %s", Token);
     }
-    if (!ProblemFileName)
+    if (!ProblemFileName && !BinaryProblemFileName)
         eprintf("Problem file name is missing");
+    if (ConvertOnly && !ProblemFileName)
+        eprintf("CONVERT_ONLY: PROBLEM_FILE specification is missing");
+    if (ConvertOnly && !BinaryProblemFileName)
+        eprintf("CONVERT_ONLY: BINARY_PROBLEM_FILE specification is "
+                "missing");
     if (SubproblemSize == 0 && SubproblemTourFileName != 0)
         eprintf("SUBPROBLEM_SIZE specification is missing");
     if (SubproblemSize > 0 && SubproblemTourFileName == 0)
@@ -11,14 +11,20 @@
  * where the first integer is a node number, and the second integer 
  * is the Pi-value associated with the node.
  *
+ * A file that starts with BINARY_PI_HEADER is read in binary (see
+ * WritePenalties.c). Its Pi-values are read as one block, and the list of
+ * nodes is not changed.
+ *
  * If reading succeeds, the function returns 1; otherwise 0.
  *
  * The function is called from the CreateCandidateSet function. 
  */
 
+static void ReadBinaryPenalties(void);
+
 int ReadPenalties()
 {
-    int i, Id;
+    int i, Id, Binary;
     Node *Na, *Nb = 0;
     static int PenaltiesRead = 0;
 
@@ -26,30 +32,52 @@ int ReadPenalties()
         return 0;
     if (PenaltiesRead || strcmp(PiFileName, "0") == 0)
         return PenaltiesRead = 1;
-    if (!(PiFile = fopen(PiFileName, "r")))
+    if (!(PiFile = OpenInputFile(PiFileName)))
         return 0;
     if (TraceLevel >= 1)
         printff("Reading PI_FILE: \"%s\" ... ", PiFileName);
-    fscanint(PiFile, &i);
+    Binary = ReadInputHeader(PiFile, BINARY_PI_HEADER);
+    ScanInt(PiFile, Binary, &i);
     if (i != Dimension)
         eprintf("PI_FILE \"%s\" does not match problem", PiFileName);
-    fscanint(PiFile, &Id);
-    assert(Id >= 1 && Id <= Dimension);
-    FirstNode = Na = &NodeSet[Id];
-    fscanint(PiFile, &Na->Pi);
-    for (i = 2; i <= Dimension; i++) {
+    if (Binary)
+        ReadBinaryPenalties();
+    else {
         fscanint(PiFile, &Id);
         assert(Id >= 1 && Id <= Dimension);
-        Nb = &NodeSet[Id];
-        fscanint(PiFile, &Nb->Pi);
-        Nb->Pred = Na;
-        Na->Suc = Nb;
-        Na = Nb;
+        FirstNode = Na = &NodeSet[InternalId(Id)];
+        fscanint(PiFile, &Na->Pi);
+        for (i = 2; i <= Dimension; i++) {
+            fscanint(PiFile, &Id);
+            assert(Id >= 1 && Id <= Dimension);
+            Nb = &NodeSet[InternalId(Id)];
+            fscanint(PiFile, &Nb->Pi);
+            Nb->Pred = Na;
+            Na->Suc = Nb;
+            Na = Nb;
+        }
+        FirstNode->Pred = Nb;
+        Nb->Suc = FirstNode;
     }
-    FirstNode->Pred = Nb;
-    Nb->Suc = FirstNode;
-    fclose(PiFile);
+    CloseInputFile(PiFile);
     if (TraceLevel >= 1)
         printff("done\n");
     return PenaltiesRead = 1;
 }
+
+/*
+ * The ReadBinaryPenalties function reads the array of Pi-values, indexed
+ * by node number (see WritePenalties.c).
+ */
+
+static void ReadBinaryPenalties()
+{
+    int i, *Pi;
+
+    assert(Pi = (int *) malloc(Dimension * sizeof(int)));
+    if (!ReadInputBytes(PiFile, Pi, Dimension * sizeof(int)))
+        eprintf("PI_FILE \"%s\": wrong size", PiFileName);
+    for (i = 1; i <= Dimension; i++)
+        NodeSet[InternalId(i)].Pi = Pi[i - 1];
+    free(Pi);
+}
@@ -1,10 +1,19 @@
 #include "LKH.h"
 #include "Heap.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 /*      
  * The ReadProblem function reads the problem data in TSPLIB format from the 
  * file specified in the parameter file (PROBLEM_FILE).
  *
+ * If a BINARY_PROBLEM_FILE is specified and exists, the problem is read
+ * from it instead, unless it is older than PROBLEM_FILE. Otherwise,
+ * PROBLEM_FILE is read and the binary file is written (see
+ * WriteBinaryProblem at the end of this file).
+ *
  * The following description of the file format is extracted from the TSPLIB 
  * documentation.  
  *
@@ -214,19 +223,30 @@ static void Read_NODE_COORD_SECTION(void);
 static void Read_NODE_COORD_TYPE(void);
 static void Read_TOUR_SECTION(FILE ** File);
 static void Read_TYPE(void);
+static void AllocateATSPMatrix(void);
+static void SetWeightType(int i);
+static int ReadBinaryProblem(int *MatrixRead);
+static void WriteBinaryProblem(void);
+static int CheapWeightType(void);
 static int TwoDWeightType(void);
 static int ThreeDWeightType(void);
+static int SmallIntegerCoordinates(void);
 
 void ReadProblem()
 {
-    int i, K;
+    int i, K, MatrixRead = 0;
     char *Line, *Keyword;
 
-    if (!(ProblemFile = fopen(ProblemFileName, "r")))
-        eprintf("Cannot open PROBLEM_FILE: \"%s\"", ProblemFileName);
-    if (TraceLevel >= 1)
-        printff("Reading PROBLEM_FILE: \"%s\" ... ", ProblemFileName);
     FreeStructures();
+    /* The largest dimension for which a cost matrix fits into MemoryLimit.
+       A computed matrix is widened to 32 bits by StoreCost and narrowed
+       again by CompressCostMatrix, and during each conversion both copies
+       exist (see CostMatrix.c) */
+    MaxMatrixDimension =
+        (int) ((1 + sqrt(1 + 8 * MemoryLimit * 1024 * 1024 /
+                         (sizeof(int) +
+                          (CostMatrixWidth < 32 ? sizeof(short) : 0)))) /
+               2);
     FirstNode = 0;
     WeightType = WeightFormat = ProblemType = -1;
     CoordType = NO_COORDS;
@@ -236,7 +256,26 @@ void ReadProblem()
     Distance = 0;
     C = 0;
     c = 0;
-    while ((Line = ReadLine(ProblemFile))) {
+    ProblemFile = 0;
+    if (BinaryProblemFileName && !ConvertOnly &&
+        ReadBinaryProblem(&MatrixRead)) {
+        if (TraceLevel >= 1)
+            printff("Reading BINARY_PROBLEM_FILE: \"%s\" ... ",
+                    BinaryProblemFileName);
+    } else if (!ProblemFileName)
+        eprintf("Cannot open BINARY_PROBLEM_FILE: \"%s\"",
+                BinaryProblemFileName);
+    else if (!(ProblemFile = OpenInputFile(ProblemFileName)))
+        eprintf("Cannot open PROBLEM_FILE: \"%s\"", ProblemFileName);
+    else if (TraceLevel >= 1) {
+        if (BinaryProblemFileName)
+            printff("Reading PROBLEM_FILE: \"%s\" "
+                    "(writing BINARY_PROBLEM_FILE: \"%s\") ... ",
+                    ProblemFileName, BinaryProblemFileName);
+        else
+            printff("Reading PROBLEM_FILE: \"%s\" ... ", ProblemFileName);
+    }
+    while (ProblemFile && (Line = ReadLine(ProblemFile))) {
         if (!(Keyword = strtok(Line, Delimiters)))
             continue;
         for (i = 0; i < (int) strlen(Keyword); i++)
@@ -279,6 +318,14 @@ void ReadProblem()
         else
             eprintf("Unknown keyword: %s", Keyword);
     }
+    if (ProblemFile && BinaryProblemFileName)
+        WriteBinaryProblem();
+    if (ConvertOnly) {
+        if (TraceLevel >= 1)
+            printff("done\n");
+        CloseInputFile(ProblemFile);
+        exit(EXIT_SUCCESS);
+    }
     Swaps = 0;
 
     /* Adjust parameters */
@@ -315,38 +362,94 @@ void ReadProblem()
         MakeHeap(Dimension);
     }
 
-    if (CostMatrix == 0 && Dimension <= MaxMatrixDimension && Distance != 0
-        && Distance != Distance_1 && Distance != Distance_ATSP) {
-        Node *Ni, *Nj;
-        assert(CostMatrix =
-               (int *) calloc((size_t) Dimension * (Dimension - 1) / 2,
-                              sizeof(int)));
+    if (NodeOrder != INPUT_ORDER)
+        RenumberNodes();
+    if (DistanceLibraryName)
+        LoadDistanceLibrary();
+    if (Distance == Distance_EUC_2D && Euc2DSinglePrecision &&
+        SmallIntegerCoordinates())
+        Distance = Distance_EUC_2D_FLOAT;
+    ComputeTrigTerms();
+    if (CostMatrixFileName && ProblemType != ATSP &&
+        CostMatrix == 0 && CostMatrix8 == 0 && CostMatrix16 == 0) {
+        if (!FirstNode) {
+            CheckSpecificationPart();
+            CreateNodes();
+        }
+        if ((MatrixRead = ReadCostMatrix())) {
+            WeightType = EXPLICIT;
+            c = 0;
+        }
+    }
+    if (CostMatrix == 0 && CostMatrix8 == 0 && CostMatrix16 == 0 &&
+        Dimension <= MaxMatrixDimension && Distance != 0 &&
+        Distance != Distance_1 && Distance != Distance_ATSP &&
+        (ProblemType == HPP || !CheapWeightType())) {
+        Node *Ni, *Nj, **To;
+        int *Dist, Count;
+        ArenaMark Mark = MarkArena(&ScratchArena);
+
+        AllocateCostMatrix();
+        /* The rows are computed in batches (see DistanceBatch) */
+        To = (Node **) ArenaAlloc(&ScratchArena, Dimension * sizeof(Node *));
+        Dist = (int *) ArenaAlloc(&ScratchArena, Dimension * sizeof(int));
         Ni = FirstNode->Suc;
         do {
-            Ni->C =
-                &CostMatrix[(size_t) (Ni->Id - 1) * (Ni->Id - 2) / 2] - 1;
-            if (ProblemType != HPP || Ni->Id < Dimension)
-                for (Nj = FirstNode; Nj != Ni; Nj = Nj->Suc)
-                    Ni->C[Nj->Id] = Fixed(Ni, Nj) ? 0 : Distance(Ni, Nj);
-            else
+            if (ProblemType != HPP || Ni->Id < Dimension) {
+                for (Count = 0, Nj = FirstNode; Nj != Ni; Nj = Nj->Suc)
+                    if (!Fixed(Ni, Nj))
+                        To[Count++] = Nj;
+                DistanceBatch(Ni, To, Count, Dist);
                 for (Nj = FirstNode; Nj != Ni; Nj = Nj->Suc)
-                    Ni->C[Nj->Id] = 0;
+                    if (Fixed(Ni, Nj))
+                        StoreCost(Ni, Nj->Id, 0);
+                for (i = 0; i < Count; i++)
+                    StoreCost(Ni, To[i]->Id, Dist[i]);
+            }
         }
         while ((Ni = Ni->Suc) != FirstNode);
+        ReleaseArena(&ScratchArena, Mark);
         WeightType = EXPLICIT;
         c = 0;
     }
-    if (Precision > 1 && (WeightType == EXPLICIT || ProblemType == ATSP)) {
+    if (WeightType == EXPLICIT && !MatrixRead) {
+        CompressCostMatrix();
+        WriteCostMatrix();
+    }
+    if (Precision > 1 && !MatrixRead &&
+        (WeightType == EXPLICIT || ProblemType == ATSP)) {
         int j, n = ProblemType == ATSP ? Dimension / 2 : Dimension;
         for (i = 2; i <= n; i++) {
             Node *N = &NodeSet[i];
-            for (j = 1; j < i; j++)
-                if (N->C[j] * Precision / Precision != N->C[j])
+            for (j = 1; j < i; j++) {
+                int W = StoredCost(N, j);
+                if (W * Precision / Precision != W)
                     eprintf("PRECISION (= %d) is too large", Precision);
+            }
         }
     }
-    C = WeightType == EXPLICIT ? C_EXPLICIT : C_FUNCTION;
-    D = WeightType == EXPLICIT ? D_EXPLICIT : D_FUNCTION;
+    if (WeightType == EXPLICIT && CostMatrix8) {
+        C = C_EXPLICIT_8;
+        D = D_EXPLICIT_8;
+        if (Distance == Distance_EXPLICIT)
+            Distance = Distance_EXPLICIT_8;
+    } else if (WeightType == EXPLICIT && CostMatrix16) {
+        C = C_EXPLICIT_16;
+        D = D_EXPLICIT_16;
+        if (Distance == Distance_EXPLICIT)
+            Distance = Distance_EXPLICIT_16;
+    } else if (WeightType == EXPLICIT && MatrixRead) {
+        C = C_EXPLICIT_32;
+        D = D_EXPLICIT_32;
+    } else {
+        C = WeightType == EXPLICIT ? C_EXPLICIT : C_FUNCTION;
+        D = WeightType == EXPLICIT ? D_EXPLICIT : D_FUNCTION;
+    }
+    if (WeightType == GEO || WeightType == GEOM ||
+        WeightType == GEO_MEEUS || WeightType == GEOM_MEEUS ||
+        (SubproblemSize > 0 && KMeansPartitioning))
+        ConvertedCoordTable =
+            (ConvertedCoords *) AllocateNodeTable(sizeof(ConvertedCoords));
     if (SubsequentMoveType == 0)
         SubsequentMoveType = MoveType;
     K = MoveType >= SubsequentMoveType
@@ -358,23 +461,6 @@ void ReadProblem()
     if (NonsequentialMoveType == -1 ||
         NonsequentialMoveType > K + PatchingC + PatchingA - 1)
         NonsequentialMoveType = K + PatchingC + PatchingA - 1;
-    if (PatchingC >= 1 && NonsequentialMoveType >= 4) {
-        BestMove = BestSubsequentMove = BestKOptMove;
-        if (!SubsequentPatching && SubsequentMoveType <= 5) {
-            MoveFunction BestOptMove[] =
-                { 0, 0, Best2OptMove, Best3OptMove,
-                Best4OptMove, Best5OptMove
-            };
-            BestSubsequentMove = BestOptMove[SubsequentMoveType];
-        }
-    } else {
-        MoveFunction BestOptMove[] = { 0, 0, Best2OptMove, Best3OptMove,
-            Best4OptMove, Best5OptMove
-        };
-        BestMove = MoveType <= 5 ? BestOptMove[MoveType] : BestKOptMove;
-        BestSubsequentMove = SubsequentMoveType <= 5 ?
-            BestOptMove[SubsequentMoveType] : BestKOptMove;
-    }
     if (ProblemType == HCP || ProblemType == HPP)
         MaxCandidates = 0;
     if (TraceLevel >= 1) {
@@ -383,8 +469,9 @@ void ReadProblem()
     } else
         printff("PROBLEM_FILE = %s\n",
                 ProblemFileName ? ProblemFileName : "");
-    fclose(ProblemFile);
-    if (InitialTourFileName)
+    if (ProblemFile)
+        CloseInputFile(ProblemFile);
+    if (InitialTourFileName && NodeOrder != INITIAL_TOUR_ORDER)
         ReadTour(InitialTourFileName, &InitialTourFile);
     if (InputTourFileName)
         ReadTour(InputTourFileName, &InputTourFile);
@@ -397,10 +484,24 @@ void ReadProblem()
         for (i = 0; i < MergeTourFiles; i++)
             ReadTour(MergeTourFileName[i], &MergeTourFile[i]);
     }
+    if (TraceLevel >= 1)
+        printff("Memory per node = %d bytes\n", BytesPerNode());
     free(LastLine);
     LastLine = 0;
 }
 
+/*
+ * The CheapWeightType function returns 1 if distances of the current
+ * weight type are so cheap to compute that a cost matrix does not pay off;
+ * otherwise 0.
+ */
+
+static int CheapWeightType()
+{
+    return WeightType == EUC_2D || WeightType == MAX_2D ||
+        WeightType == MAN_2D || WeightType == CEIL_2D;
+}
+
 static int TwoDWeightType()
 {
     return WeightType == EUC_2D || WeightType == MAX_2D ||
@@ -419,6 +520,30 @@ static int ThreeDWeightType()
         (WeightType == SPECIAL && CoordType == THREED_COORDS);
 }
 
+/*
+ * The SmallIntegerCoordinates function returns 1 if the X and Y
+ * coordinates of all nodes are integers less than 2^20 in absolute value;
+ * otherwise 0. For such coordinates the squared Euclidean distance is an
+ * exact integer (see Distance_EUC_2D_FLOAT).
+ */
+
+static int SmallIntegerCoordinates()
+{
+    const double Limit = 1 << 20;
+    Node *N;
+
+    if (!FirstNode)
+        return 0;
+    N = FirstNode;
+    do {
+        if (N->X != floor(N->X) || N->Y != floor(N->Y) ||
+            fabs(N->X) >= Limit || fabs(N->Y) >= Limit)
+            return 0;
+    }
+    while ((N = N->Suc) != FirstNode);
+    return 1;
+}
+
 static void CheckSpecificationPart()
 {
     if (ProblemType == -1)
@@ -488,6 +613,34 @@ static void CheckSpecificationPart()
         eprintf("Illegal EDGE_WEIGHT_TYPE for SIERPINSKI specification");
     if (SubproblemBorders && !TwoDWeightType() && !ThreeDWeightType())
         eprintf("Illegal EDGE_WEIGHT_TYPE for BORDERS specification");
+    if (NodeOrder != INPUT_ORDER &&
+        (ProblemType == ATSP || ProblemType == HPP ||
+         WeightType == EXPLICIT))
+        eprintf("Illegal TYPE or EDGE_WEIGHT_TYPE for NODE_ORDER");
+    if (NodeOrder == MOORE_ORDER && !TwoDWeightType()
+        && !ThreeDWeightType())
+        eprintf("Illegal EDGE_WEIGHT_TYPE for NODE_ORDER = MOORE");
+    if (NodeOrder == SIERPINSKI_ORDER && !TwoDWeightType()
+        && !ThreeDWeightType())
+        eprintf("Illegal EDGE_WEIGHT_TYPE for NODE_ORDER = SIERPINSKI");
+    if (NodeOrder == INITIAL_TOUR_ORDER && !InitialTourFileName)
+        eprintf("NODE_ORDER = INITIAL_TOUR: INITIAL_TOUR_FILE is missing");
+    if (DistanceLibraryName &&
+        (WeightType != SPECIAL || ProblemType != TSP))
+        eprintf("DISTANCE_LIBRARY: TYPE = TSP and "
+                "EDGE_WEIGHT_TYPE = SPECIAL expected");
+    if (DistanceLibraryName && KMeansPartitioning)
+        eprintf("DISTANCE_LIBRARY cannot be used with K-MEANS "
+                "specification");
+    /* The quadrant and nearest-neighbor candidate sets compute distances
+       to points that are not nodes */
+    if (DistanceLibraryName &&
+        (((CandidateSetType == NN || CandidateSetType == QUADRANT) &&
+          MaxCandidates > 0) ||
+         ((ExtraCandidateSetType == NN || ExtraCandidateSetType == QUADRANT)
+          && ExtraCandidates > 0)))
+        eprintf("DISTANCE_LIBRARY cannot be used with NEAREST-NEIGHBOR or "
+                "QUADRANT candidate sets");
 }
 
 static char *Copy(char *S)
@@ -515,7 +668,7 @@ static void CreateNodes()
         if (Dimension > MaxMatrixDimension)
             eprintf("Dimension too large in HPP problem");
     }
-    assert(NodeSet = (Node *) calloc(Dimension + 1, sizeof(Node)));
+    NodeSet = (Node *) LargeCalloc(Dimension + 1, sizeof(Node));
     for (i = 1; i <= Dimension; i++, Prev = N) {
         N = &NodeSet[i];
         if (i == 1)
@@ -523,11 +676,11 @@ static void CreateNodes()
         else
             Link(Prev, N);
         N->Id = i;
-        if (MergeTourFiles >= 1)
-            assert(N->MergeSuc =
-                   (Node **) calloc(MergeTourFiles, sizeof(Node *)));
     }
     Link(N, FirstNode);
+    if (MergeTourFiles >= 1)
+        MergeSucTable =
+            (Node **) AllocateNodeTable(MergeTourFiles * sizeof(Node *));
 }
 
 static void Read_NAME()
@@ -574,9 +727,9 @@ static void Read_DISPLAY_DATA_SECTION()
             eprintf("(DIPLAY_DATA_SECTION) Node number occours twice: %d",
                     N->Id);
         N->V = 1;
-        if (!fscanf(ProblemFile, "%lf", &N->X))
+        if (!fscandouble(ProblemFile, &N->X))
             eprintf("Missing X-coordinate in DIPLAY_DATA_SECTION");
-        if (!fscanf(ProblemFile, "%lf", &N->Y))
+        if (!fscandouble(ProblemFile, &N->Y))
             eprintf("Missing Y-coordinate in DIPLAY_DATA_SECTION");
     }
     N = FirstNode;
@@ -803,6 +956,22 @@ static void Read_EDGE_WEIGHT_FORMAT()
         eprintf("Unknown EDGE_WEIGHT_FORMAT: %s", EdgeWeightFormat);
 }
 
+/*
+ * The AllocateATSPMatrix function allocates the full matrix of an ATSP
+ * instance with Dimension / 2 original nodes. Row i is referenced by the
+ * field C of node i.
+ */
+
+static void AllocateATSPMatrix()
+{
+    Node *N;
+    int n = Dimension / 2;
+
+    CostMatrix = (int *) LargeCalloc((size_t) n * n, sizeof(int));
+    for (N = FirstNode; N->Id <= n; N = N->Suc)
+        N->C = &CostMatrix[(size_t) (N->Id - 1) * n] - 1;
+}
+
 static void Read_EDGE_WEIGHT_SECTION()
 {
     Node *Ni, *Nj;
@@ -811,22 +980,10 @@ static void Read_EDGE_WEIGHT_SECTION()
     CheckSpecificationPart();
     if (!FirstNode)
         CreateNodes();
-    if (ProblemType != ATSP) {
-        assert(CostMatrix =
-               (int *) calloc((size_t) Dimension * (Dimension - 1) / 2,
-                              sizeof(int)));
-        Ni = FirstNode->Suc;
-        do {
-            Ni->C =
-                &CostMatrix[(size_t) (Ni->Id - 1) * (Ni->Id - 2) / 2] - 1;
-        }
-        while ((Ni = Ni->Suc) != FirstNode);
-    } else {
-        n = Dimension / 2;
-        assert(CostMatrix = (int *) calloc((size_t) n * n, sizeof(int)));
-        for (Ni = FirstNode; Ni->Id <= n; Ni = Ni->Suc)
-            Ni->C = &CostMatrix[(size_t) (Ni->Id - 1) * n] - 1;
-    }
+    if (ProblemType != ATSP)
+        AllocateCostMatrix();
+    else
+        AllocateATSPMatrix();
     if (ProblemType == HPP)
         Dimension--;
     switch (WeightFormat) {
@@ -860,7 +1017,7 @@ static void Read_EDGE_WEIGHT_SECTION()
                     if (!fscanint(ProblemFile, &W))
                         eprintf("Missing weight in EDGE_WEIGHT_SECTION");
                     if (j < i)
-                        Ni->C[j] = W;
+                        StoreCost(Ni, j, W);
                 }
             }
         break;
@@ -870,7 +1027,7 @@ static void Read_EDGE_WEIGHT_SECTION()
                  j++, Nj = Nj->Suc) {
                 if (!fscanint(ProblemFile, &W))
                     eprintf("Missing weight in EDGE_WEIGHT_SECTION");
-                Nj->C[i] = W;
+                StoreCost(Nj, i, W);
             }
         }
         break;
@@ -879,7 +1036,7 @@ static void Read_EDGE_WEIGHT_SECTION()
             for (j = 1; j < i; j++) {
                 if (!fscanint(ProblemFile, &W))
                     eprintf("Missing weight in EDGE_WEIGHT_SECTION");
-                Ni->C[j] = W;
+                StoreCost(Ni, j, W);
             }
         }
         break;
@@ -889,7 +1046,7 @@ static void Read_EDGE_WEIGHT_SECTION()
                 if (!fscanint(ProblemFile, &W))
                     eprintf("Missing weight in EDGE_WEIGHT_SECTION");
                 if (i != j)
-                    Nj->C[i] = W;
+                    StoreCost(Nj, i, W);
             }
         }
         break;
@@ -899,7 +1056,7 @@ static void Read_EDGE_WEIGHT_SECTION()
                 if (!fscanint(ProblemFile, &W))
                     eprintf("Missing weight in EDGE_WEIGHT_SECTION");
                 if (j != i)
-                    Ni->C[j] = W;
+                    StoreCost(Ni, j, W);
             }
         }
         break;
@@ -908,7 +1065,7 @@ static void Read_EDGE_WEIGHT_SECTION()
             for (i = 1; i < j; i++) {
                 if (!fscanint(ProblemFile, &W))
                     eprintf("Missing weight in EDGE_WEIGHT_SECTION");
-                Nj->C[i] = W;
+                StoreCost(Nj, i, W);
             }
         }
         break;
@@ -918,7 +1075,7 @@ static void Read_EDGE_WEIGHT_SECTION()
                  i++, Ni = Ni->Suc) {
                 if (!fscanint(ProblemFile, &W))
                     eprintf("Missing weight in EDGE_WEIGHT_SECTION");
-                Ni->C[j] = W;
+                StoreCost(Ni, j, W);
             }
         }
         break;
@@ -928,7 +1085,7 @@ static void Read_EDGE_WEIGHT_SECTION()
                 if (!fscanint(ProblemFile, &W))
                     eprintf("Missing weight in EDGE_WEIGHT_SECTION");
                 if (i != j)
-                    Nj->C[i] = W;
+                    StoreCost(Nj, i, W);
             }
         }
         break;
@@ -938,7 +1095,7 @@ static void Read_EDGE_WEIGHT_SECTION()
                 if (!fscanint(ProblemFile, &W))
                     eprintf("Missing weight in EDGE_WEIGHT_SECTION");
                 if (i != j)
-                    Ni->C[j] = W;
+                    StoreCost(Ni, j, W);
             }
         }
         break;
@@ -947,6 +1104,39 @@ static void Read_EDGE_WEIGHT_SECTION()
         Dimension++;
 }
 
+/*
+ * The edge weight types given by coordinates, with their distance functions,
+ * lower-bound functions and coordinate types (-1: not given by the type).
+ */
+
+static const struct {
+    char *Name;
+    int Type;
+    CostFunction Distance, c;
+    int CoordType;
+} WeightTypes[] = {
+    {"ATT", ATT, Distance_ATT, c_ATT, TWOD_COORDS},
+    {"CEIL_2D", CEIL_2D, Distance_CEIL_2D, c_CEIL_2D, TWOD_COORDS},
+    {"CEIL_3D", CEIL_3D, Distance_CEIL_3D, c_CEIL_3D, THREED_COORDS},
+    {"EUC_2D", EUC_2D, Distance_EUC_2D, c_EUC_2D, TWOD_COORDS},
+    {"EUC_3D", EUC_3D, Distance_EUC_3D, c_EUC_3D, THREED_COORDS},
+    {"EXPLICIT", EXPLICIT, Distance_EXPLICIT, 0, -1},
+    {"MAN_2D", MAN_2D, Distance_MAN_2D, c_MAN_2D, TWOD_COORDS},
+    {"MAN_3D", MAN_3D, Distance_MAN_3D, c_MAN_3D, THREED_COORDS},
+    {"MAX_2D", MAX_2D, Distance_MAX_2D, c_MAX_2D, TWOD_COORDS},
+    {"MAX_3D", MAX_3D, Distance_MAX_3D, c_MAX_3D, THREED_COORDS},
+    {"GEO", GEO, Distance_GEO, c_GEO, TWOD_COORDS},
+    {"GEOM", GEOM, Distance_GEOM, c_GEOM, TWOD_COORDS},
+    {"GEO_MEEUS", GEO_MEEUS, Distance_GEO_MEEUS, c_GEO_MEEUS, TWOD_COORDS},
+    {"GEOM_MEEUS", GEOM_MEEUS, Distance_GEOM_MEEUS, c_GEOM_MEEUS,
+     TWOD_COORDS},
+    {"XRAY1", XRAY1, Distance_XRAY1, c_XRAY1, THREED_COORDS},
+    {"XRAY2", XRAY2, Distance_XRAY2, c_XRAY2, THREED_COORDS},
+    {"SPECIAL", SPECIAL, Distance_SPECIAL, 0, -1}
+};
+
+#define WEIGHT_TYPES (sizeof(WeightTypes) / sizeof(WeightTypes[0]))
+
 static void Read_EDGE_WEIGHT_TYPE()
 {
     unsigned int i;
@@ -955,83 +1145,28 @@ static void Read_EDGE_WEIGHT_TYPE()
         eprintf("EDGE_WEIGHT_TYPE: string expected");
     for (i = 0; i < strlen(EdgeWeightType); i++)
         EdgeWeightType[i] = (char) toupper(EdgeWeightType[i]);
-    if (!strcmp(EdgeWeightType, "ATT")) {
-        WeightType = ATT;
-        Distance = Distance_ATT;
-        c = c_ATT;
-        CoordType = TWOD_COORDS;
-    } else if (!strcmp(EdgeWeightType, "CEIL_2D")) {
-        WeightType = CEIL_2D;
-        Distance = Distance_CEIL_2D;
-        c = c_CEIL_2D;
-        CoordType = TWOD_COORDS;
-    } else if (!strcmp(EdgeWeightType, "CEIL_3D")) {
-        WeightType = CEIL_3D;
-        Distance = Distance_CEIL_3D;
-        c = c_CEIL_3D;
-        CoordType = THREED_COORDS;
-    } else if (!strcmp(EdgeWeightType, "EUC_2D")) {
-        WeightType = EUC_2D;
-        Distance = Distance_EUC_2D;
-        c = c_EUC_2D;
-        CoordType = TWOD_COORDS;
-    } else if (!strcmp(EdgeWeightType, "EUC_3D")) {
-        WeightType = EUC_3D;
-        Distance = Distance_EUC_3D;
-        c = c_EUC_3D;
-        CoordType = THREED_COORDS;
-    } else if (!strcmp(EdgeWeightType, "EXPLICIT")) {
-        WeightType = EXPLICIT;
-        Distance = Distance_EXPLICIT;
-    } else if (!strcmp(EdgeWeightType, "MAN_2D")) {
-        WeightType = MAN_2D;
-        Distance = Distance_MAN_2D;
-        CoordType = TWOD_COORDS;
-    } else if (!strcmp(EdgeWeightType, "MAN_3D")) {
-        WeightType = MAN_3D;
-        Distance = Distance_MAN_3D;
-        CoordType = THREED_COORDS;
-    } else if (!strcmp(EdgeWeightType, "MAX_2D")) {
-        WeightType = MAX_2D;
-        Distance = Distance_MAX_2D;
-        CoordType = TWOD_COORDS;
-    } else if (!strcmp(EdgeWeightType, "MAX_3D")) {
-        WeightType = MAX_3D;
-        Distance = Distance_MAX_3D;
-        CoordType = THREED_COORDS;
-    } else if (!strcmp(EdgeWeightType, "GEO")) {
-        WeightType = GEO;
-        Distance = Distance_GEO;
-        c = c_GEO;
-        CoordType = TWOD_COORDS;
-    } else if (!strcmp(EdgeWeightType, "GEOM")) {
-        WeightType = GEOM;
-        Distance = Distance_GEOM;
-        c = c_GEOM;
-        CoordType = TWOD_COORDS;
-    } else if (!strcmp(EdgeWeightType, "GEO_MEEUS")) {
-        WeightType = GEO_MEEUS;
-        Distance = Distance_GEO_MEEUS;
-        c = c_GEO_MEEUS;
-        CoordType = TWOD_COORDS;
-    } else if (!strcmp(EdgeWeightType, "GEOM_MEEUS")) {
-        WeightType = GEOM_MEEUS;
-        Distance = Distance_GEOM_MEEUS;
-        c = c_GEOM_MEEUS;
-        CoordType = TWOD_COORDS;
-    } else if (!strcmp(EdgeWeightType, "XRAY1")) {
-        WeightType = XRAY1;
-        Distance = Distance_XRAY1;
-        CoordType = THREED_COORDS;
-    } else if (!strcmp(EdgeWeightType, "XRAY2")) {
-        WeightType = XRAY2;
-        Distance = Distance_XRAY2;
-        CoordType = THREED_COORDS;
-    } else if (!strcmp(EdgeWeightType, "SPECIAL")) {
-        WeightType = SPECIAL;
-        Distance = Distance_SPECIAL;
-    } else
-        eprintf("Unknown EDGE_WEIGHT_TYPE: %s", EdgeWeightType);
+    for (i = 0; i < WEIGHT_TYPES; i++) {
+        if (!strcmp(EdgeWeightType, WeightTypes[i].Name)) {
+            SetWeightType(i);
+            return;
+        }
+    }
+    eprintf("Unknown EDGE_WEIGHT_TYPE: %s", EdgeWeightType);
+}
+
+/*
+ * The SetWeightType function sets WeightType, Distance, c and CoordType
+ * as given by entry i of WeightTypes.
+ */
+
+static void SetWeightType(int i)
+{
+    WeightType = WeightTypes[i].Type;
+    Distance = WeightTypes[i].Distance;
+    if (WeightTypes[i].c)
+        c = WeightTypes[i].c;
+    if (WeightTypes[i].CoordType != -1)
+        CoordType = WeightTypes[i].CoordType;
 }
 
 static void Read_FIXED_EDGES_SECTION()
@@ -1117,12 +1252,12 @@ static void Read_NODE_COORD_SECTION()
             eprintf("(NODE_COORD_SECTION) Node number occours twice: %d",
                     N->Id);
         N->V = 1;
-        if (!fscanf(ProblemFile, "%lf", &N->X))
+        if (!fscandouble(ProblemFile, &N->X))
             eprintf("Missing X-coordinate in NODE_COORD_SECTION");
-        if (!fscanf(ProblemFile, "%lf", &N->Y))
+        if (!fscandouble(ProblemFile, &N->Y))
             eprintf("Missing Y-coordinate in NODE_COORD_SECTION");
         if (CoordType == THREED_COORDS
-            && !fscanf(ProblemFile, "%lf", &N->Z))
+            && !fscandouble(ProblemFile, &N->Z))
             eprintf("Missing Z-coordinate in NODE_COORD_SECTION");
         if (Name && !strcmp(Name, "d657")) {
             N->X = (float) N->X;
@@ -1181,6 +1316,13 @@ static void Read_TOUR_SECTION(FILE ** File)
     }
     if (!FirstNode)
         CreateNodes();
+    if (File == &InitialTourFile && !InitialSucTable)
+        InitialSucTable = (Node **) AllocateNodeTable(sizeof(Node *));
+    else if (File == &InputTourFile && !InputSucTable)
+        InputSucTable = (Node **) AllocateNodeTable(sizeof(Node *));
+    else if (File == &SubproblemTourFile && !SubproblemLinkTable)
+        SubproblemLinkTable =
+            (SubproblemLinks *) AllocateNodeTable(sizeof(SubproblemLinks));
     N = FirstNode;
     do
         N->V = 0;
@@ -1194,9 +1336,9 @@ static void Read_TOUR_SECTION(FILE ** File)
     for (k = 0; k <= Dimension && i != -1; k++) {
         if (i <= 0 || i > Dimension)
             eprintf("(TOUR_SECTION) Node number out of range: %d", i);
-        N = &NodeSet[i];
+        N = &NodeSet[InternalId(i)];
         if (N->V == 1 && k != Dimension)
-            eprintf("(TOUR_SECTION) Node number occours twice: %d", N->Id);
+            eprintf("(TOUR_SECTION) Node number occours twice: %d", i);
         N->V = 1;
         if (k == 0)
             First = Last = N;
@@ -1208,33 +1350,36 @@ static void Read_TOUR_SECTION(FILE ** File)
                 Na = 0;
             if (File == &InitialTourFile) {
                 if (!Na)
-                    Last->InitialSuc = N;
+                    InitialSuc(Last) = N;
                 else {
-                    Last->InitialSuc = Na;
-                    Na->InitialSuc = N;
+                    InitialSuc(Last) = Na;
+                    InitialSuc(Na) = N;
                 }
             } else if (File == &InputTourFile) {
                 if (!Na)
-                    Last->InputSuc = N;
+                    InputSuc(Last) = N;
                 else {
-                    Last->InputSuc = Na;
-                    Na->InputSuc = N;
+                    InputSuc(Last) = Na;
+                    InputSuc(Na) = N;
                 }
             } else if (File == &SubproblemTourFile) {
-                if (!Na)
-                    (Last->SubproblemSuc = N)->SubproblemPred = Last;
-                else {
-                    (Last->SubproblemSuc = Na)->SubproblemPred = Last;
-                    (Na->SubproblemSuc = N)->SubproblemPred = Na;
+                if (!Na) {
+                    SubproblemSuc(Last) = N;
+                    SubproblemPred(N) = Last;
+                } else {
+                    SubproblemSuc(Last) = Na;
+                    SubproblemPred(Na) = Last;
+                    SubproblemSuc(Na) = N;
+                    SubproblemPred(N) = Na;
                 }
             } else {
                 for (i = 0; i < MergeTourFiles; i++) {
                     if (File == &MergeTourFile[i]) {
                         if (!Na)
-                            Last->MergeSuc[i] = N;
+                            MergeSuc(Last, i) = N;
                         else {
-                            Last->MergeSuc[i] = Na;
-                            Na->MergeSuc[i] = N;
+                            MergeSuc(Last, i) = Na;
+                            MergeSuc(Na, i) = N;
                         }
                     }
                 }
@@ -1244,26 +1389,27 @@ static void Read_TOUR_SECTION(FILE ** File)
         if (k < Dimension)
             fscanint(*File, &i);
         if (k == Dimension - 1)
-            i = First->Id;
+            i = ExternalId(First->Id);
     }
     N = FirstNode;
     do
         if (!N->V)
-            eprintf("(TOUR_SECTION) Node is missing: %d", N->Id);
+            eprintf("(TOUR_SECTION) Node is missing: %d",
+                    ExternalId(N->Id));
     while ((N = N->Suc) != FirstNode);
     if (File == &SubproblemTourFile) {
         do {
             if (N->FixedTo1 &&
-                N->SubproblemPred != N->FixedTo1
-                && N->SubproblemSuc != N->FixedTo1)
+                SubproblemPred(N) != N->FixedTo1
+                && SubproblemSuc(N) != N->FixedTo1)
                 eprintf("Fixed edge (%d, %d) "
-                        "does not belong to subproblem tour", N->Id,
-                        N->FixedTo1->Id);
-            if (N->FixedTo2 && N->SubproblemPred != N->FixedTo2
-                && N->SubproblemSuc != N->FixedTo2)
+                        "does not belong to subproblem tour",
+                        ExternalId(N->Id), ExternalId(N->FixedTo1->Id));
+            if (N->FixedTo2 && SubproblemPred(N) != N->FixedTo2
+                && SubproblemSuc(N) != N->FixedTo2)
                 eprintf("Fixed edge (%d, %d) "
-                        "does not belong to subproblem tour", N->Id,
-                        N->FixedTo2->Id);
+                        "does not belong to subproblem tour",
+                        ExternalId(N->Id), ExternalId(N->FixedTo2->Id));
         } while ((N = N->Suc) != FirstNode);
     }
     if (ProblemType == HPP)
@@ -1331,7 +1477,7 @@ void ReadTour(char *FileName, FILE ** File)
     unsigned int i;
     int Done = 0;
 
-    if (!(*File = fopen(FileName, "r")))
+    if (!(*File = OpenInputFile(FileName)))
         eprintf("Cannot open tour file: \"%s\"", FileName);
     while ((Line = ReadLine(*File))) {
         if (!(Keyword = strtok(Line, Delimiters)))
@@ -1376,5 +1522,253 @@ void ReadTour(char *FileName, FILE ** File)
     }
     if (!Done)
         eprintf("Missing TOUR_SECTION in tour file: \"%s\"", FileName);
-    fclose(*File);
+    CloseInputFile(*File);
+}
+
+/*
+ * A BINARY_PROBLEM_FILE holds the problem as it is after PROBLEM_FILE has
+ * been read, in the native byte order. It consists of
+ *
+ *   (1) a header of BINARY_HEADER_SIZE bytes (see BinaryHeader), which
+ *       records, among other things, the size and modification time of
+ *       PROBLEM_FILE when the binary file was written,
+ *   (2) the NAME, padded to a multiple of 8 bytes,
+ *   (3) if any node has a non-zero coordinate, the X-, Y- and
+ *       Z-coordinates of the Dimension nodes (three arrays of doubles),
+ *   (4) if any edge is fixed, the numbers of the nodes each node is fixed
+ *       to (two arrays of Dimension ints, 0 for none), and
+ *   (5) if the weights are given explicitly, the cost matrix: for a
+ *       symmetric problem the lower triangle with entries of MatrixWidth
+ *       bits, stored exactly as by CostMatrix.c, and for an ATSP instance
+ *       the full matrix of ints.
+ *
+ * ReadBinaryProblem maps the file into memory and copies the coordinates
+ * and fixed edges to the nodes. A symmetric cost matrix is not copied: the
+ * matrix refers to the mapped entries (see MapCostMatrix).
+ *
+ * An EDGE_DATA_SECTION cannot be stored in the file.
+ */
+
+#define BINARY_HEADER_SIZE 128
+#define BINARY_MAGIC "LKHPROB"
+#define BINARY_VERSION 1
+
+typedef struct BinaryHeader {
+    char Magic[8];
+    int Version;
+    int Dimension;              /* Number of nodes (0 if none created) */
+    int DimensionSaved, ProblemType, WeightType, WeightFormat, CoordType;
+    int M;                      /* The M-value of an ATSP instance */
+    int NameLength, Coordinates, FixedEdges;
+    int MatrixWidth;            /* 0 if there is no matrix */
+    int MatrixOffset, MatrixMin, MatrixMax;
+    long long SourceSize;       /* Size of PROBLEM_FILE */
+    long long SourceTime;       /* Modification time of PROBLEM_FILE */
+} BinaryHeader;
+
+static size_t Padded(size_t Size)
+{
+    return (Size + 7) & ~(size_t) 7;
+}
+
+static size_t MatrixBytes(BinaryHeader * H)
+{
+    size_t n = (size_t) H->Dimension;
+
+    if (!H->MatrixWidth)
+        return 0;
+    if (H->ProblemType == ATSP)
+        return n / 2 * (n / 2) * sizeof(int);
+    return n * (n - 1) / 2 * (H->MatrixWidth / 8);
+}
+
+/*
+ * The ReadBinaryProblem function reads the problem from BINARY_PROBLEM_FILE.
+ * If the file does not exist, or if it does not match the size and
+ * modification time of PROBLEM_FILE, the function returns 0; otherwise 1.
+ * MatrixRead is set to 1 if a cost matrix has been mapped.
+ */
+
+static int ReadBinaryProblem(int *MatrixRead)
+{
+    BinaryHeader H;
+    struct stat Stat, Source;
+    char *Data, *Pos;
+    size_t Size, n;
+    int File, i;
+
+    if ((File = open(BinaryProblemFileName, O_RDONLY)) == -1)
+        return 0;
+    if (fstat(File, &Stat) || read(File, &H, sizeof(H)) != sizeof(H) ||
+        strncmp(H.Magic, BINARY_MAGIC, sizeof(H.Magic)))
+        eprintf("BINARY_PROBLEM_FILE \"%s\": not a binary problem file",
+                BinaryProblemFileName);
+    if (ProblemFileName &&
+        (H.Version != BINARY_VERSION ||
+         (!stat(ProblemFileName, &Source) &&
+          ((long long) Source.st_size != H.SourceSize ||
+           (long long) Source.st_mtime != H.SourceTime)))) {
+        close(File);
+        return 0;
+    }
+    if (H.Version != BINARY_VERSION)
+        eprintf("BINARY_PROBLEM_FILE \"%s\": wrong version",
+                BinaryProblemFileName);
+    n = (size_t) H.Dimension;
+    Size = BINARY_HEADER_SIZE + Padded((size_t) H.NameLength) +
+        (H.Coordinates ? 3 * n * sizeof(double) : 0) +
+        (H.FixedEdges ? 2 * n * sizeof(int) : 0) + MatrixBytes(&H);
+    if ((size_t) Stat.st_size != Size)
+        eprintf("BINARY_PROBLEM_FILE \"%s\": wrong size",
+                BinaryProblemFileName);
+    if ((Data = (char *) mmap(0, Size, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                              File, 0)) == MAP_FAILED)
+        eprintf("BINARY_PROBLEM_FILE \"%s\": cannot be mapped",
+                BinaryProblemFileName);
+    close(File);
+    Pos = Data + BINARY_HEADER_SIZE;
+    free(Name);
+    assert(Name = (char *) malloc(H.NameLength + 1));
+    memcpy(Name, Pos, H.NameLength);
+    Name[H.NameLength] = '\0';
+    Pos += Padded((size_t) H.NameLength);
+    ProblemType = H.ProblemType;
+    WeightFormat = H.WeightFormat;
+    for (i = 0; i < (int) WEIGHT_TYPES; i++)
+        if (WeightTypes[i].Type == H.WeightType)
+            SetWeightType(i);
+    WeightType = H.WeightType;
+    CoordType = H.CoordType;
+    Dimension = DimensionSaved = H.DimensionSaved;
+    M = H.M;
+    if (H.Dimension) {
+        CheckSpecificationPart();
+        CreateNodes();
+        if (Dimension != H.Dimension)
+            eprintf("BINARY_PROBLEM_FILE \"%s\": wrong DIMENSION",
+                    BinaryProblemFileName);
+    }
+    if (H.Coordinates) {
+        double *X = (double *) Pos, *Y = X + n, *Z = Y + n;
+        for (i = 1; i <= Dimension; i++) {
+            NodeSet[i].X = X[i - 1];
+            NodeSet[i].Y = Y[i - 1];
+            NodeSet[i].Z = Z[i - 1];
+        }
+        Pos += 3 * n * sizeof(double);
+    }
+    if (H.FixedEdges) {
+        int *To1 = (int *) Pos, *To2 = To1 + n;
+        for (i = 1; i <= Dimension; i++) {
+            NodeSet[i].FixedTo1 = To1[i - 1] ? &NodeSet[To1[i - 1]] : 0;
+            NodeSet[i].FixedTo2 = To2[i - 1] ? &NodeSet[To2[i - 1]] : 0;
+        }
+        Pos += 2 * n * sizeof(int);
+    }
+    if (H.MatrixWidth && ProblemType == ATSP) {
+        AllocateATSPMatrix();
+        memcpy(CostMatrix, Pos, MatrixBytes(&H));
+        Distance = Distance_ATSP;
+    } else if (H.MatrixWidth) {
+        MapCostMatrix(Data, Size, (size_t) (Pos - Data), H.MatrixWidth,
+                      H.MatrixOffset, H.MatrixMin, H.MatrixMax);
+        *MatrixRead = 1;
+        return 1;
+    }
+    munmap(Data, Size);
+    return 1;
+}
+
+/*
+ * The WriteBinaryProblem function writes the problem just read from
+ * PROBLEM_FILE to BINARY_PROBLEM_FILE. The file is written under a
+ * temporary name, which is renamed when the whole file has been written.
+ */
+
+static void WriteBinaryProblem()
+{
+    BinaryHeader H;
+    struct stat Source;
+    char Bytes[BINARY_HEADER_SIZE], *TempName;
+    FILE *File;
+    Node *N;
+    double *X = 0;
+    int *To = 0, i, j;
+    size_t n;
+
+    if (EdgeDataFormat)
+        eprintf("BINARY_PROBLEM_FILE cannot be used with "
+                "EDGE_DATA_SECTION");
+    memset(&H, 0, sizeof(H));
+    strcpy(H.Magic, BINARY_MAGIC);
+    H.Version = BINARY_VERSION;
+    H.Dimension = FirstNode ? Dimension : 0;
+    H.DimensionSaved = DimensionSaved;
+    H.ProblemType = ProblemType;
+    H.WeightType = WeightType;
+    H.WeightFormat = WeightFormat;
+    H.CoordType = CoordType;
+    H.M = M;
+    H.NameLength = Name ? (int) strlen(Name) : 0;
+    if ((N = FirstNode)) {
+        do {
+            if (N->X != 0 || N->Y != 0 || N->Z != 0)
+                H.Coordinates = 1;
+            if (N->FixedTo1)
+                H.FixedEdges = 1;
+        } while ((N = N->Suc) != FirstNode);
+    }
+    if (ProblemType == ATSP && CostMatrix)
+        H.MatrixWidth = 32;
+    else if (ProblemType != ATSP &&
+             (CostMatrix || CostMatrix8 || CostMatrix16)) {
+        H.MatrixWidth = CostMatrix8 ? 8 : CostMatrix16 ? 16 : 32;
+        H.MatrixOffset = CostMatrixOffset;
+        CostMatrixRange(&H.MatrixMin, &H.MatrixMax);
+    }
+    if (!stat(ProblemFileName, &Source)) {
+        H.SourceSize = (long long) Source.st_size;
+        H.SourceTime = (long long) Source.st_mtime;
+    }
+    assert(TempName = (char *) malloc(strlen(BinaryProblemFileName) + 5));
+    sprintf(TempName, "%s.tmp", BinaryProblemFileName);
+    if (!(File = fopen(TempName, "wb")))
+        eprintf("Cannot open BINARY_PROBLEM_FILE: \"%s\"", TempName);
+    memset(Bytes, 0, sizeof(Bytes));
+    memcpy(Bytes, &H, sizeof(H));
+    fwrite(Bytes, 1, sizeof(Bytes), File);
+    fwrite(Name, 1, H.NameLength, File);
+    fwrite(Bytes + sizeof(H), 1,
+           Padded((size_t) H.NameLength) - H.NameLength, File);
+    n = (size_t) H.Dimension;
+    if (H.Coordinates) {
+        assert(X = (double *) malloc(n * sizeof(double)));
+        for (j = 0; j < 3; j++) {
+            for (i = 1; i <= Dimension; i++)
+                X[i - 1] = j == 0 ? NodeSet[i].X :
+                    j == 1 ? NodeSet[i].Y : NodeSet[i].Z;
+            fwrite(X, sizeof(double), n, File);
+        }
+        free(X);
+    }
+    if (H.FixedEdges) {
+        assert(To = (int *) malloc(n * sizeof(int)));
+        for (j = 0; j < 2; j++) {
+            for (i = 1; i <= Dimension; i++) {
+                N = j == 0 ? NodeSet[i].FixedTo1 : NodeSet[i].FixedTo2;
+                To[i - 1] = N ? N->Id : 0;
+            }
+            fwrite(To, sizeof(int), n, File);
+        }
+        free(To);
+    }
+    if (H.MatrixWidth)
+        fwrite(CostMatrix8 ? (void *) CostMatrix8 :
+               CostMatrix16 ? (void *) CostMatrix16 : (void *) CostMatrix,
+               1, MatrixBytes(&H), File);
+    if (ferror(File) | fclose(File) ||
+        rename(TempName, BinaryProblemFileName))
+        eprintf("Cannot write BINARY_PROBLEM_FILE: \"%s\"",
+                BinaryProblemFileName);
+    free(TempName);
 }
@@ -7,7 +7,8 @@
  * The function is called by LKHmain each time a run has resulted in a
  * shorter tour. Thus, when the predetermined number of runs have been
  * completed, BestTour contains an array representation of the best tour
- * found.    
+ * found. The tour is given by internal node numbers; WriteTour converts
+ * them to the node numbers of the problem file (see RenumberNodes).
  */
 /*
   RecordBestTour()函数会把当前的最优解记录到BestTour[]数组中
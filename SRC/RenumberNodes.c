@@ -0,0 +1,109 @@
+#include "LKH.h"
+
+/*
+ * The RenumberNodes function renumbers the nodes in the order given by
+ * NODE_ORDER, and rearranges NodeSet accordingly. The order is either the
+ * order of the nodes along a space-filling curve (MOORE or SIERPINSKI) or
+ * the order of the nodes in the tour given by INITIAL_TOUR_FILE.
+ *
+ * In the input order, nodes that are neighbors in good tours are usually
+ * far apart in NodeSet. After renumbering they are mostly stored close to
+ * each other, so tour traversals, flips, minimum spanning tree computations
+ * and candidate scans access memory in a mostly sequential manner.
+ *
+ * The new numbers are only used internally. The node numbers in files
+ * (tours, candidates and Pi-values) are converted by the macros ExternalId
+ * and InternalId (see LKH.h), which use the tables ExternalIdTable and
+ * InternalIdTable.
+ *
+ * The function is called by ReadProblem after the problem file has been
+ * read, and before the trigonometric terms and the cost matrix (if any)
+ * are computed. Any fixed edges and EDGE_DATA_SECTION edges are carried
+ * over. If NODE_ORDER is INITIAL_TOUR, the initial tour is read here.
+ */
+
+static int compare(const void *Na, const void *Nb);
+
+#define NewNode(N) ((N) ? &NewSet[(N)->V] : 0)
+
+void RenumberNodes()
+{
+    Node *N, *NewSet, **Perm, **Table;
+    Candidate *NN;
+    double XMin, XMax, YMin, YMax;
+    int i;
+    ArenaMark Mark;
+
+    Mark = MarkArena(&ScratchArena);
+    Perm = (Node **) ArenaAlloc(&ScratchArena, Dimension * sizeof(Node *));
+    if (NodeOrder == INITIAL_TOUR_ORDER) {
+        ReadTour(InitialTourFileName, &InitialTourFile);
+        for (i = 0, N = FirstNode; i < Dimension; i++, N = InitialSuc(N))
+            Perm[i] = N;
+    } else {
+        N = FirstNode;
+        XMin = XMax = N->X;
+        YMin = YMax = N->Y;
+        while ((N = N->Suc) != FirstNode) {
+            if (N->X < XMin)
+                XMin = N->X;
+            else if (N->X > XMax)
+                XMax = N->X;
+            if (N->Y < YMin)
+                YMin = N->Y;
+            else if (N->Y > YMax)
+                YMax = N->Y;
+        }
+        if (XMax == XMin)
+            XMax = XMin + 1;
+        if (YMax == YMin)
+            YMax = YMin + 1;
+        for (i = 0, N = FirstNode; i < Dimension; i++, N = N->Suc) {
+            double x = (N->X - XMin) / (XMax - XMin);
+            double y = (N->Y - YMin) / (YMax - YMin);
+            (Perm[i] = N)->V = NodeOrder == SIERPINSKI_ORDER ?
+                SierpinskiIndex(x, y) : MooreIndex(x, y);
+        }
+        qsort(Perm, Dimension, sizeof(Node *), compare);
+    }
+
+    /* The V field of an old node holds its new number */
+    for (i = 0; i < Dimension; i++)
+        Perm[i]->V = i + 1;
+    NewSet = (Node *) LargeCalloc(Dimension + 1, sizeof(Node));
+    ExternalIdTable = (int *) AllocateNodeTable(sizeof(int));
+    InternalIdTable = (int *) AllocateNodeTable(sizeof(int));
+    for (i = 1; i <= Dimension; i++) {
+        N = &NewSet[i];
+        *N = *Perm[i - 1];
+        N->Id = i;
+        N->V = 0;
+        ExternalIdTable[i] = Perm[i - 1]->Id;
+        InternalIdTable[Perm[i - 1]->Id] = i;
+        N->FixedTo1 = NewNode(N->FixedTo1);
+        N->FixedTo2 = NewNode(N->FixedTo2);
+        for (NN = N->CandidateSet; NN && NN->To; NN++)
+            NN->To = NewNode(NN->To);
+        if (i > 1)
+            Link(&NewSet[i - 1], N);
+    }
+    Link(&NewSet[Dimension], &NewSet[1]);
+    if (InitialSucTable) {
+        Table = (Node **) AllocateNodeTable(sizeof(Node *));
+        for (i = 1; i <= Dimension; i++)
+            Table[i] = NewNode(InitialSucTable[ExternalIdTable[i]]);
+        LargeFree(InitialSucTable);
+        InitialSucTable = Table;
+    }
+    ReleaseArena(&ScratchArena, Mark);
+    LargeFree(NodeSet);
+    NodeSet = NewSet;
+    FirstNode = &NodeSet[1];
+}
+
+static int compare(const void *Na, const void *Nb)
+{
+    int NaV = (*(Node **) Na)->V;
+    int NbV = (*(Node **) Nb)->V;
+    return NaV < NbV ? -1 : NaV > NbV ? 1 : 0;
+}
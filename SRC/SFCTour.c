@@ -18,8 +18,6 @@
  * The function returns the cost of the resulting tour. 
  */
 
-static int SierpinskiIndex(double x, double y);
-static int MooreIndex(double x, double y);
 static int compare(const void *Na, const void *Nb);
 
 typedef int (*IndexFunction) (double x, double y);
@@ -32,6 +30,7 @@ GainType SFCTour(int CurveType)
     IndexFunction Index;
     GainType Cost;
     double EntryTime = GetTime();
+    ArenaMark Mark;
 
     if (CurveType == SIERPINSKI) {
         if (TraceLevel >= 1)
@@ -61,7 +60,8 @@ GainType SFCTour(int CurveType)
     if (YMax == YMin)
         YMax = YMin + 1;
 
-    assert(Perm = (Node **) malloc(Dimension * sizeof(Node *)));
+    Mark = MarkArena(&ScratchArena);
+    Perm = (Node **) ArenaAlloc(&ScratchArena, Dimension * sizeof(Node *));
     for (i = 0, N = FirstNode; i < Dimension; i++, N = N->Suc)
         (Perm[i] = N)->V =
             Index((N->X - XMin) / (XMax - XMin),
@@ -69,7 +69,7 @@ GainType SFCTour(int CurveType)
     qsort(Perm, Dimension, sizeof(Node *), compare);
     for (i = 1; i < Dimension; i++)
         Follow(Perm[i], Perm[i - 1]);
-    free(Perm);
+    ReleaseArena(&ScratchArena, Mark);
 
     /* Assure that all fixed or common edges belong to the tour */
     N = FirstNode;
@@ -101,7 +101,13 @@ GainType SFCTour(int CurveType)
     return Cost;
 }
 
-static int SierpinskiIndex(double x, double y)
+/*
+ * The SierpinskiIndex and MooreIndex functions return the position of the
+ * point (x, y), where 0 <= x, y <= 1, along the respective curve. The
+ * functions are also used by RenumberNodes.
+ */
+
+int SierpinskiIndex(double x, double y)
 {
     int idx = 0;
     double oldx;
@@ -135,7 +141,7 @@ static int SierpinskiIndex(double x, double y)
     return idx;
 }
 
-static int MooreIndex(double x, double y)
+int MooreIndex(double x, double y)
 {
     static const int Rank[5][4] =
         { {1, 0, 2, 3}, {2, 3, 1, 0}, {2, 1, 3, 0}, {0, 3, 1, 2},
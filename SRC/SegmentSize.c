@@ -7,10 +7,10 @@
  * Note, however, that if the two-level list is used, the number 
  * of nodes is only approximate (for efficiency reasons).
  * 
- * Time complexity: O(1).
+ * Time complexity: O(1), or O(log n) expected if the balanced tree is used.
  */
 
-#ifdef ONE_LEVEL_TREE
+#if defined ONE_LEVEL_TREE || defined ARRAY_TREE
 
 int SegmentSize(Node * ta, Node * tb)
 {
@@ -18,6 +18,15 @@ int SegmentSize(Node * ta, Node * tb)
     return (n < 0 ? n + Dimension : n) + 1;
 }
 
+#elif defined BALANCED_TREE
+
+int SegmentSize(Node * ta, Node * tb)
+{
+    int n = !Reversed ? Position_BT(tb) - Position_BT(ta) :
+        Position_BT(ta) - Position_BT(tb);
+    return (n < 0 ? n + Dimension : n) + 1;
+}
+
 # elif defined TWO_LEVEL_TREE
 
 int SegmentSize(Node * ta, Node * tb)
@@ -1,5 +1,5 @@
-#include "Sequence.h"
 #include "Segment.h"
+#include "Sequence.h"
 
 /*
  * This file contains the functions FindPermutation and FeasibleKOptMove.
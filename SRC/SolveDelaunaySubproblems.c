@@ -31,11 +31,11 @@ void SolveDelaunaySubproblems()
     GlobalBestCost = 0;
     N = FirstNode;
     do {
-        if (!Fixed(N, N->SubproblemSuc))
-            GlobalBestCost += Distance(N, N->SubproblemSuc);
+        if (!Fixed(N, SubproblemSuc(N)))
+            GlobalBestCost += Distance(N, SubproblemSuc(N));
         N->Subproblem = 0;
     }
-    while ((N = N->SubproblemSuc) != FirstNode);
+    while ((N = SubproblemSuc(N)) != FirstNode);
     if (TraceLevel >= 1) {
         if (TraceLevel >= 2)
             printff("\n");
@@ -127,12 +127,12 @@ static int DelaunayClustering(int MaxClusterSize)
         if (N != FirstNode) {
             N = FirstNode;
             do
-                N->Zc = N->Y;
+                Zc(N) = N->Y;
             while ((N = N->Suc) != FirstNode);
             /* Transform longitude (180 and -180 map to 0) */
             From = FirstNode;
             do {
-                From->Zc = From->Y;
+                Zc(From) = From->Y;
                 if (WeightType == GEO || WeightType == GEO_MEEUS)
                     From->Y =
                         (int) From->Y + 5.0 * (From->Y -
@@ -145,7 +145,7 @@ static int DelaunayClustering(int MaxClusterSize)
             } while ((From = From->Suc) != FirstNode);
             delaunay(Dimension);
             do
-                From->Y = From->Zc;
+                From->Y = Zc(From);
             while ((From = From->Suc) != FirstNode);
 
             qsort(EdgeSet, Count, sizeof(Edge), compareFromTo);
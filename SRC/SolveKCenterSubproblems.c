@@ -30,11 +30,11 @@ void SolveKCenterSubproblems()
     GlobalBestCost = 0;
     N = FirstNode;
     do {
-        if (!Fixed(N, N->SubproblemSuc))
-            GlobalBestCost += Distance(N, N->SubproblemSuc);
+        if (!Fixed(N, SubproblemSuc(N)))
+            GlobalBestCost += Distance(N, SubproblemSuc(N));
         N->Subproblem = 0;
     }
-    while ((N = N->SubproblemSuc) != FirstNode);
+    while ((N = SubproblemSuc(N)) != FirstNode);
     if (TraceLevel >= 1) {
         if (TraceLevel >= 2)
             printff("\n");
@@ -72,8 +72,9 @@ static void KCenterClustering(int K)
 {
     Node **Center, *N;
     int d, dMax, i;
+    ArenaMark Mark = MarkArena(&ScratchArena);
 
-    assert(Center = (Node **) calloc((K + 1), sizeof(Node *)));
+    Center = (Node **) ArenaCalloc(&ScratchArena, K + 1, sizeof(Node *));
 
     /* Pick first cluster arbitrarily */
     Center[1] = &NodeSet[Random() % Dimension + 1];
@@ -101,5 +102,5 @@ static void KCenterClustering(int K)
            } 
         } while ((N = N->Suc) != FirstNode);
     }
-    free(Center);
+    ReleaseArena(&ScratchArena, Mark);
 }
@@ -31,11 +31,11 @@ void SolveKMeansSubproblems()
     GlobalBestCost = 0;
     N = FirstNode;
     do {
-        if (!Fixed(N, N->SubproblemSuc))
-            GlobalBestCost += Distance(N, N->SubproblemSuc);
+        if (!Fixed(N, SubproblemSuc(N)))
+            GlobalBestCost += Distance(N, SubproblemSuc(N));
         N->Subproblem = 0;
     }
-    while ((N = N->SubproblemSuc) != FirstNode);
+    while ((N = SubproblemSuc(N)) != FirstNode);
     if (TraceLevel >= 1) {
         if (TraceLevel >= 2)
             printff("\n");
@@ -80,20 +80,23 @@ void SolveKMeansSubproblems()
 
 static void KMeansClustering(int K)
 {
-    Node *Center, **Perm, *N, Old;
-    int *Count, i, j, d, OldSubproblem;
+    Node *Center, **Perm, **To, *N, Old = {0};
+    int *Count, *Dist, i, j, d, OldSubproblem, Targets;
     double *SumXc, *SumYc, *SumZc, Xc, Yc, Zc;
     int *Movement, *MMax, Max;
     int Moving = 0;
+    ArenaMark Mark = MarkArena(&ScratchArena);
 
-    assert(Center = (Node *) calloc((K + 1), sizeof(Node)));
-    assert(SumXc = (double *) calloc(K + 1, sizeof(double)));
-    assert(SumYc = (double *) calloc(K + 1, sizeof(double)));
-    assert(SumZc = (double *) calloc(K + 1, sizeof(double)));
-    assert(Count = (int *) calloc(K + 1, sizeof(int)));
-    assert(Movement = (int *) calloc(K + 1, sizeof(int)));
-    assert(MMax = (int *) calloc(K + 1, sizeof(int)));
-    assert(Perm = (Node **) malloc(Dimension * sizeof(Node *)));
+    Center = (Node *) ArenaCalloc(&ScratchArena, K + 1, sizeof(Node));
+    SumXc = (double *) ArenaCalloc(&ScratchArena, K + 1, sizeof(double));
+    SumYc = (double *) ArenaCalloc(&ScratchArena, K + 1, sizeof(double));
+    SumZc = (double *) ArenaCalloc(&ScratchArena, K + 1, sizeof(double));
+    Count = (int *) ArenaCalloc(&ScratchArena, K + 1, sizeof(int));
+    Movement = (int *) ArenaCalloc(&ScratchArena, K + 1, sizeof(int));
+    MMax = (int *) ArenaCalloc(&ScratchArena, K + 1, sizeof(int));
+    Perm = (Node **) ArenaAlloc(&ScratchArena, Dimension * sizeof(Node *));
+    To = (Node **) ArenaAlloc(&ScratchArena, K * sizeof(Node *));
+    Dist = (int *) ArenaAlloc(&ScratchArena, K * sizeof(int));
 
     /* Pick random initial centers */
     for (i = 0; i < Dimension; i++)
@@ -116,25 +119,25 @@ static void KMeansClustering(int K)
         N->BestPi = N->Pi;
         N->Pi = 0;
         if (WeightType == GEO || WeightType == GEO_MEEUS)
-            GEO2XYZ(N->X, N->Y, &N->Xc, &N->Yc, &N->Zc);
+            GEO2XYZ(N->X, N->Y, &Xc(N), &Yc(N), &Zc(N));
         else if (WeightType == GEOM || WeightType == GEOM_MEEUS)
-            GEOM2XYZ(N->X, N->Y, &N->Xc, &N->Yc, &N->Zc);
+            GEOM2XYZ(N->X, N->Y, &Xc(N), &Yc(N), &Zc(N));
         else {
-            N->Xc = N->X;
-            N->Yc = N->Y;
-            N->Zc = N->Z;
+            Xc(N) = N->X;
+            Yc(N) = N->Y;
+            Zc(N) = N->Z;
         }
         N->Cost = INT_MAX / 2;
         N->M = INT_MIN;
         N->Subproblem = N->LastV = 0;
-        SumXc[0] += N->Xc;
-        SumYc[0] += N->Yc;
-        SumZc[0] += N->Zc;
+        SumXc[0] += Xc(N);
+        SumYc[0] += Yc(N);
+        SumZc[0] += Zc(N);
         Count[0]++;
     } while ((N = N->Suc) != FirstNode);
-    Xc = Center[0].Xc = SumXc[0] / Count[0];
-    Yc = Center[0].Yc = SumYc[0] / Count[0];
-    Zc = Center[0].Zc = SumZc[0] / Count[0];
+    Xc = SumXc[0] / Count[0];
+    Yc = SumYc[0] / Count[0];
+    Zc = SumZc[0] / Count[0];
     if (WeightType == GEO || WeightType == GEO_MEEUS)
         XYZ2GEO(Xc, Yc, Zc, &Center[0].X, &Center[0].Y);
     if (WeightType == GEOM || WeightType == GEOM_MEEUS)
@@ -168,25 +171,26 @@ static void KMeansClustering(int K)
                         N->Cost = d;
                     }
                 }
-                for (i = 1; i <= K; i++) {
-                    if (i == N->Subproblem || i == N->LastV)
-                        continue;
-                    d = INT_MIN;
+                /* Compute the distances to the centers that may become
+                   the closest or the second closest center */
+                for (i = 1, Targets = 0; i <= K; i++)
+                    if (i != N->Subproblem && i != N->LastV &&
+                        (!c || c(N, &Center[i]) <= N->Cost ||
+                         c(N, &Center[i]) < N->NextCost))
+                        To[Targets++] = &Center[i];
+                DistanceBatch(N, To, Targets, Dist);
+                for (j = 0; j < Targets; j++) {
+                    i = To[j] - Center;
+                    d = Dist[j] * Precision;
                     if ((!c || c(N, &Center[i]) <= N->Cost) &&
-                        (d =
-                         Distance(N, &Center[i]) * Precision) <= N->Cost) {
+                        d <= N->Cost) {
                         N->NextCost = N->Cost;
                         N->Cost = d;
                         N->LastV = N->Subproblem;
                         if (d < N->NextCost)
                             N->Subproblem = i;
-                    } else if (d < N->NextCost &&
-                               (!c || c(N, &Center[i]) < N->NextCost) &&
-                               (d != INT_MIN || (d =
-                                                 Distance(N,
-                                                          &Center[i]) *
-                                                 Precision) <
-                                N->NextCost)) {
+                    } else if ((!c || c(N, &Center[i]) < N->NextCost) &&
+                               d < N->NextCost) {
                         N->NextCost = d;
                         N->LastV = i;
                     }
@@ -194,13 +198,13 @@ static void KMeansClustering(int K)
                 N->M = N->NextCost - N->Cost;
                 if (N->Subproblem != OldSubproblem) {
                     Moving++;
-                    SumXc[OldSubproblem] -= N->Xc;
-                    SumYc[OldSubproblem] -= N->Yc;
-                    SumZc[OldSubproblem] -= N->Zc;
+                    SumXc[OldSubproblem] -= Xc(N);
+                    SumYc[OldSubproblem] -= Yc(N);
+                    SumZc[OldSubproblem] -= Zc(N);
                     Count[OldSubproblem]--;
-                    SumXc[N->Subproblem] += N->Xc;
-                    SumYc[N->Subproblem] += N->Yc;
-                    SumZc[N->Subproblem] += N->Zc;
+                    SumXc[N->Subproblem] += Xc(N);
+                    SumYc[N->Subproblem] += Yc(N);
+                    SumZc[N->Subproblem] += Zc(N);
                     Count[N->Subproblem]++;
                 }
             }
@@ -217,9 +221,9 @@ static void KMeansClustering(int K)
                 Old.X = Center[i].X;
                 Old.Y = Center[i].Y;
                 Old.Z = Center[i].Z;
-                Xc = Center[i].Xc = SumXc[i] / Count[i];
-                Yc = Center[i].Yc = SumYc[i] / Count[i];
-                Zc = Center[i].Zc = SumZc[i] / Count[i];
+                Xc = SumXc[i] / Count[i];
+                Yc = SumYc[i] / Count[i];
+                Zc = SumZc[i] / Count[i];
                 if (WeightType == GEO || WeightType == GEO_MEEUS)
                     XYZ2GEO(Xc, Yc, Zc, &Center[i].X, &Center[i].Y);
                 else if (WeightType == GEOM || WeightType == GEOM_MEEUS)
@@ -251,12 +255,5 @@ static void KMeansClustering(int K)
     do
         N->Pi = N->BestPi;
     while ((N = N->Suc) != FirstNode);
-    free(Center);
-    free(SumXc);
-    free(SumYc);
-    free(SumZc);
-    free(Count);
-    free(Perm);
-    free(Movement);
-    free(MMax);
+    ReleaseArena(&ScratchArena, Mark);
 }
@@ -26,6 +26,7 @@ void SolveKarpSubproblems()
 {
     Node *N;
     double EntryTime = GetTime();
+    ArenaMark Mark;
 
     AllocateStructures();
     ReadPenalties();
@@ -34,11 +35,11 @@ void SolveKarpSubproblems()
     GlobalBestCost = 0;
     N = FirstNode;
     do {
-        if (!Fixed(N, N->SubproblemSuc))
-            GlobalBestCost += Distance(N, N->SubproblemSuc);
+        if (!Fixed(N, SubproblemSuc(N)))
+            GlobalBestCost += Distance(N, SubproblemSuc(N));
         N->Subproblem = 0;
     }
-    while ((N = N->SubproblemSuc) != FirstNode);
+    while ((N = SubproblemSuc(N)) != FirstNode);
     if (TraceLevel >= 1) {
         if (TraceLevel >= 2)
             printff("\n");
@@ -49,25 +50,26 @@ void SolveKarpSubproblems()
         WeightType == GEO_MEEUS || WeightType == GEOM_MEEUS) {
         N = FirstNode;
         do {
-            N->Xc = N->X;
-            N->Yc = N->Y;
-            N->Zc = N->Z;
+            Xc(N) = N->X;
+            Yc(N) = N->Y;
+            Zc(N) = N->Z;
             if (WeightType == GEO || WeightType == GEO_MEEUS)
-                GEO2XYZ(N->Xc, N->Yc, &N->X, &N->Y, &N->Z);
+                GEO2XYZ(Xc(N), Yc(N), &N->X, &N->Y, &N->Z);
             else
-                GEOM2XYZ(N->Xc, N->Yc, &N->X, &N->Y, &N->Z);
-        } while ((N = N->SubproblemSuc) != FirstNode);
+                GEOM2XYZ(Xc(N), Yc(N), &N->X, &N->Y, &N->Z);
+        } while ((N = SubproblemSuc(N)) != FirstNode);
         CoordType = THREED_COORDS;
     }
+    Mark = MarkArena(&ScratchArena);
     KDTree = BuildKDTree(SubproblemSize);
     if (WeightType == GEO || WeightType == GEOM ||
         WeightType == GEO_MEEUS || WeightType == GEOM_MEEUS) {
         N = FirstNode;
         do {
-            N->X = N->Xc;
-            N->Y = N->Yc;
-            N->Z = N->Zc;
-        } while ((N = N->SubproblemSuc) != FirstNode);
+            N->X = Xc(N);
+            N->Y = Yc(N);
+            N->Z = Zc(N);
+        } while ((N = SubproblemSuc(N)) != FirstNode);
         CoordType = TWOD_COORDS;
     }
 
@@ -75,7 +77,7 @@ void SolveKarpSubproblems()
     CalculateSubproblems(0, Dimension - 1);
     CurrentSubproblem = 0;
     KarpPartition(0, Dimension - 1);
-    free(KDTree);
+    ReleaseArena(&ScratchArena, Mark);
     printff("\nCost = " GainFormat, GlobalBestCost);
     if (Optimum != MINUS_INFINITY && Optimum != 0)
         printff(", Gap = %0.4f%%",
@@ -32,6 +32,7 @@ void SolveRoheSubproblems()
     Node *N;
     int CurrentSubproblem, Subproblems, Remaining, i;
     GainType GlobalBestCost, OldGlobalBestCost;
+    ArenaMark Mark;
     double XMin, XMax, YMin, YMax, ZMin, ZMax, DX, DY, DZ, CLow, CMid,
         CHigh;
     double EntryTime = GetTime();
@@ -44,11 +45,11 @@ void SolveRoheSubproblems()
     GlobalBestCost = 0;
     N = FirstNode;
     do {
-        if (!Fixed(N, N->SubproblemSuc))
-            GlobalBestCost += Distance(N, N->SubproblemSuc);
+        if (!Fixed(N, SubproblemSuc(N)))
+            GlobalBestCost += Distance(N, SubproblemSuc(N));
         N->Subproblem = 0;
     }
-    while ((N = N->SubproblemSuc) != FirstNode);
+    while ((N = SubproblemSuc(N)) != FirstNode);
     if (TraceLevel >= 1) {
         if (TraceLevel >= 2)
             printff("\n");
@@ -59,21 +60,21 @@ void SolveRoheSubproblems()
         WeightType == GEO_MEEUS || WeightType == GEOM_MEEUS) {
         N = FirstNode;
         do {
-            N->Xc = N->X;
-            N->Yc = N->Y;
-            N->Zc = N->Z;
+            Xc(N) = N->X;
+            Yc(N) = N->Y;
+            Zc(N) = N->Z;
             if (WeightType == GEO || WeightType == GEO_MEEUS)
-                GEO2XYZ(N->Xc, N->Yc, &N->X, &N->Y, &N->Z);
+                GEO2XYZ(Xc(N), Yc(N), &N->X, &N->Y, &N->Z);
             else
-                GEOM2XYZ(N->Xc, N->Yc, &N->X, &N->Y, &N->Z);
-        } while ((N = N->SubproblemSuc) != FirstNode);
+                GEOM2XYZ(Xc(N), Yc(N), &N->X, &N->Y, &N->Z);
+        } while ((N = SubproblemSuc(N)) != FirstNode);
         CoordType = THREED_COORDS;
     }
     N = FirstNode;
     XMin = XMax = N->X;
     YMin = YMax = N->Y;
     ZMin = ZMax = N->Z;
-    while ((N = N->SubproblemSuc) != FirstNode) {
+    while ((N = SubproblemSuc(N)) != FirstNode) {
         if (N->X < XMin)
             XMin = N->X;
         else if (N->X > XMax)
@@ -87,6 +88,7 @@ void SolveRoheSubproblems()
         else if (N->Z > ZMax)
             ZMax = N->Z;
     }
+    Mark = MarkArena(&ScratchArena);
     KDTree = BuildKDTree(SubproblemSize);
     Remaining = Dimension;
     while (Remaining > SubproblemSize) {
@@ -132,13 +134,13 @@ void SolveRoheSubproblems()
         || WeightType == GEOM_MEEUS) {
         N = FirstNode;
         do {
-            N->X = N->Xc;
-            N->Y = N->Yc;
-            N->Z = N->Zc;
-        } while ((N = N->SubproblemSuc) != FirstNode);
+            N->X = Xc(N);
+            N->Y = Yc(N);
+            N->Z = Zc(N);
+        } while ((N = SubproblemSuc(N)) != FirstNode);
         CoordType = TWOD_COORDS;
     }
-    free(KDTree);
+    ReleaseArena(&ScratchArena, Mark);
     for (CurrentSubproblem = 1;
          CurrentSubproblem <= Subproblems; CurrentSubproblem++) {
         OldGlobalBestCost = GlobalBestCost;
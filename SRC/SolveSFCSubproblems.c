@@ -24,9 +24,12 @@ void SolveSFCSubproblems()
     GainType GlobalBestCost, OldGlobalBestCost;
     Node **Suc;
     double EntryTime = GetTime();
+    ArenaMark Mark;
 
     SFCTour(SierpinskiPartitioning ? SIERPINSKI : MOORE);
-    assert(Suc = (Node **) malloc((1 + Dimension) * sizeof(Node *)));
+    Mark = MarkArena(&ScratchArena);
+    Suc = (Node **)
+        ArenaAlloc(&ScratchArena, (1 + Dimension) * sizeof(Node *));
     N = FirstNode;
     do
         Suc[N->Id] = N->Suc;
@@ -40,11 +43,11 @@ void SolveSFCSubproblems()
     GlobalBestCost = 0;
     N = FirstNodeSaved = FirstNode;
     do {
-        if (!Fixed(N, N->SubproblemSuc))
-            GlobalBestCost += Distance(N, N->SubproblemSuc);
+        if (!Fixed(N, SubproblemSuc(N)))
+            GlobalBestCost += Distance(N, SubproblemSuc(N));
         N->Subproblem = 0;
     }
-    while ((N = N->SubproblemSuc) != FirstNode);
+    while ((N = SubproblemSuc(N)) != FirstNode);
     for (Round = 1; Round <= 2; Round++) {
         if (Round == 2 && Subproblems == 1)
             break;
@@ -68,7 +71,7 @@ void SolveSFCSubproblems()
                 N->Subproblem =
                     (Round - 1) * Subproblems + CurrentSubproblem;
                 N->FixedTo1Saved = N->FixedTo2Saved = 0;
-                N->SubBestPred = N->SubBestSuc = 0;
+                SubBestPred(N) = SubBestSuc(N) = 0;
             }
             OldGlobalBestCost = GlobalBestCost;
             SolveSubproblem((Round - 1) * Subproblems + CurrentSubproblem,
@@ -81,7 +84,7 @@ void SolveSFCSubproblems()
             FirstNode = N;
         }
     }
-    free(Suc);
+    ReleaseArena(&ScratchArena, Mark);
     printff("\nCost = " GainFormat, GlobalBestCost);
     if (Optimum != MINUS_INFINITY && Optimum != 0)
         printff(", Gap = %0.4f%%",
@@ -12,6 +12,9 @@
  *
  * If the subproblem is too small (Dimension <= 3), the function returns 0;
  * otherwise 1. 
+ *
+ * All space allocated from ScratchArena while the subproblem is solved
+ * (e.g., the population) is released in one step when it has been solved.
  */
 
 int
@@ -24,6 +27,7 @@ SolveSubproblem(int CurrentSubproblem, int Subproblems,
     int NewDimension = 0, OldDimension = 0, Number, i, InitialTourEdges = 0,
         AscentCandidatesSaved = AscentCandidates,
         InitialPeriodSaved = InitialPeriod, MaxTrialsSaved = MaxTrials;
+    ArenaMark ScratchMark;
 
     BestCost = PLUS_INFINITY;
     FirstNode = 0;
@@ -31,26 +35,26 @@ SolveSubproblem(int CurrentSubproblem, int Subproblems,
     do {
         if (N->Subproblem == CurrentSubproblem) {
             if (SubproblemsCompressed &&
-                (((N->SubproblemPred == N->SubBestPred ||
-                   FixedOrCommon(N, N->SubproblemPred) ||
-                   (N->SubBestPred &&
-                    (N->FixedTo1Saved == N->SubBestPred ||
-                     N->FixedTo2Saved == N->SubBestPred))) &&
-                  (N->SubproblemSuc == N->SubBestSuc ||
-                   FixedOrCommon(N, N->SubproblemSuc) ||
-                   (N->SubBestSuc &&
-                    (N->FixedTo1Saved == N->SubBestSuc ||
-                     N->FixedTo2Saved == N->SubBestSuc)))) ||
-                 ((N->SubproblemPred == N->SubBestSuc ||
-                   FixedOrCommon(N, N->SubproblemPred) ||
-                   (N->SubBestSuc &&
-                    (N->FixedTo1Saved == N->SubBestSuc ||
-                     N->FixedTo2Saved == N->SubBestSuc))) &&
-                  (N->SubproblemSuc == N->SubBestPred ||
-                   FixedOrCommon(N, N->SubproblemSuc) ||
-                   (N->SubBestPred &&
-                    (N->FixedTo1Saved == N->SubBestPred ||
-                     N->FixedTo2Saved == N->SubBestPred))))))
+                (((SubproblemPred(N) == SubBestPred(N) ||
+                   FixedOrCommon(N, SubproblemPred(N)) ||
+                   (SubBestPred(N) &&
+                    (N->FixedTo1Saved == SubBestPred(N) ||
+                     N->FixedTo2Saved == SubBestPred(N)))) &&
+                  (SubproblemSuc(N) == SubBestSuc(N) ||
+                   FixedOrCommon(N, SubproblemSuc(N)) ||
+                   (SubBestSuc(N) &&
+                    (N->FixedTo1Saved == SubBestSuc(N) ||
+                     N->FixedTo2Saved == SubBestSuc(N))))) ||
+                 ((SubproblemPred(N) == SubBestSuc(N) ||
+                   FixedOrCommon(N, SubproblemPred(N)) ||
+                   (SubBestSuc(N) &&
+                    (N->FixedTo1Saved == SubBestSuc(N) ||
+                     N->FixedTo2Saved == SubBestSuc(N)))) &&
+                  (SubproblemSuc(N) == SubBestPred(N) ||
+                   FixedOrCommon(N, SubproblemSuc(N)) ||
+                   (SubBestPred(N) &&
+                    (N->FixedTo1Saved == SubBestPred(N) ||
+                     N->FixedTo2Saved == SubBestPred(N)))))))
                 N->Subproblem = -CurrentSubproblem;
             else {
                 if (!FirstNode)
@@ -58,13 +62,13 @@ SolveSubproblem(int CurrentSubproblem, int Subproblems,
                 NewDimension++;
             }
             N->Head = N->Tail = 0;
-            if (N->SubBestSuc)
+            if (SubBestSuc(N))
                 OldDimension++;
         }
-        N->SubBestPred = N->SubBestSuc = 0;
+        SubBestPred(N) = SubBestSuc(N) = 0;
         N->FixedTo1Saved = N->FixedTo1;
         N->FixedTo2Saved = N->FixedTo2;
-    } while ((N = N->SubproblemSuc) != FirstNodeSaved);
+    } while ((N = SubproblemSuc(N)) != FirstNodeSaved);
     if ((Number = CurrentSubproblem % Subproblems) == 0)
         Number = Subproblems;
     if (NewDimension <= 3 || NewDimension == OldDimension) {
@@ -79,6 +83,7 @@ SolveSubproblem(int CurrentSubproblem, int Subproblems,
         FirstNode = FirstNodeSaved;
         return 0;
     }
+    ScratchMark = MarkArena(&ScratchArena);
     if (AscentCandidates > NewDimension - 1)
         AscentCandidates = NewDimension - 1;
     if (InitialPeriod < 0) {
@@ -92,7 +97,7 @@ SolveSubproblem(int CurrentSubproblem, int Subproblems,
         MaxTrials = NewDimension;
     N = FirstNode;
     do {
-        Next = N->SubproblemSuc;
+        Next = SubproblemSuc(N);
         if (N->Subproblem == CurrentSubproblem) {
             N->Pred = N->Suc = N;
             if (N != FirstNode)
@@ -110,13 +115,13 @@ SolveSubproblem(int CurrentSubproblem, int Subproblems,
                 Next->FixedTo1 = Last;
             else
                 Next->FixedTo2 = Last;
-            if (C == C_EXPLICIT) {
+            if (WeightType == EXPLICIT) {
                 if (Last->Id > Next->Id) {
-                    Last->SavedCost = Last->C[Next->Id];
-                    Last->C[Next->Id] = 0;
+                    Last->SavedCost = StoredCost(Last, Next->Id);
+                    StoreCost(Last, Next->Id, 0);
                 } else {
-                    Next->SavedCost = Next->C[Last->Id];
-                    Next->C[Last->Id] = 0;
+                    Next->SavedCost = StoredCost(Next, Last->Id);
+                    StoreCost(Next, Last->Id, 0);
                 }
             }
         }
@@ -126,22 +131,24 @@ SolveSubproblem(int CurrentSubproblem, int Subproblems,
     Dimension = NewDimension;
     AllocateSegments();
     InitializeStatistics();
-    if (CacheSig)
-        for (i = 0; i <= CacheMask; i++)
-            CacheSig[i] = 0;
+    if (DistanceCache)
+        memset(DistanceCache, 0, (CacheMask + 1) * sizeof(CacheSet));
     OptimumSaved = Optimum;
     Optimum = 0;
     N = FirstNode;
     do {
-        if (N->SubproblemSuc == N->InitialSuc ||
-            N->SubproblemPred == N->InitialSuc)
+        if (InitialSucTable &&
+            (SubproblemSuc(N) == InitialSuc(N) ||
+             SubproblemPred(N) == InitialSuc(N)))
             InitialTourEdges++;
         if (!Fixed(N, N->Suc))
             Optimum += Distance(N, N->Suc);
         if (N->FixedTo1 && N->Subproblem != N->FixedTo1->Subproblem)
-            eprintf("Illegal fixed edge (%d,%d)", N->Id, N->FixedTo1->Id);
+            eprintf("Illegal fixed edge (%d,%d)", ExternalId(N->Id),
+                    ExternalId(N->FixedTo1->Id));
         if (N->FixedTo2 && N->Subproblem != N->FixedTo2->Subproblem)
-            eprintf("Illegal fixed edge (%d,%d)", N->Id, N->FixedTo2->Id);
+            eprintf("Illegal fixed edge (%d,%d)", ExternalId(N->Id),
+                    ExternalId(N->FixedTo2->Id));
         N->BestSuc = N->Suc;
     }
     while ((N = N->Suc) != FirstNode);
@@ -165,7 +172,7 @@ SolveSubproblem(int CurrentSubproblem, int Subproblems,
                 Last = N;
             }
         }
-        while ((N = N->SubproblemSuc) != FirstNode);
+        while ((N = SubproblemSuc(N)) != FirstNode);
         Last->Next = FirstNode;
         Cost = MergeWithTour();
         if (MaxPopulationSize > 1) {
@@ -187,8 +194,8 @@ SolveSubproblem(int CurrentSubproblem, int Subproblems,
         if (Cost < BestCost) {
             N = FirstNode;
             do {
-                N->SubBestPred = N->Pred;
-                N->SubBestSuc = N->Suc;
+                SubBestPred(N) = N->Pred;
+                SubBestSuc(N) = N->Suc;
             } while ((N = N->Suc) != FirstNode);
             BestCost = Cost;
         }
@@ -202,18 +209,18 @@ SolveSubproblem(int CurrentSubproblem, int Subproblems,
             N = FirstNode;
             do
                 N->Mark = 0;
-            while ((N = N->SubproblemSuc) != FirstNode);
+            while ((N = SubproblemSuc(N)) != FirstNode);
             do {
                 N->Mark = N;
-                if (!N->SubproblemSuc->Mark &&
+                if (!SubproblemSuc(N)->Mark &&
                     (N->Subproblem != CurrentSubproblem ||
-                     N->SubproblemSuc->Subproblem != CurrentSubproblem))
-                    N->BestSuc = N->SubproblemSuc;
-                else if (!N->SubproblemPred->Mark &&
+                     SubproblemSuc(N)->Subproblem != CurrentSubproblem))
+                    N->BestSuc = SubproblemSuc(N);
+                else if (!SubproblemPred(N)->Mark &&
                          (N->Subproblem != CurrentSubproblem ||
-                          N->SubproblemPred->Subproblem !=
+                          SubproblemPred(N)->Subproblem !=
                           CurrentSubproblem))
-                    N->BestSuc = N->SubproblemPred;
+                    N->BestSuc = SubproblemPred(N);
                 else if (!N->Suc->Mark)
                     N->BestSuc = N->Suc;
                 else if (!N->Pred->Mark)
@@ -245,19 +252,20 @@ SolveSubproblem(int CurrentSubproblem, int Subproblems,
                 do
                     if (N->Subproblem != CurrentSubproblem)
                         break;
-                while ((N = N->SubproblemPred) != FirstNode);
-                if (N->SubproblemSuc == N->BestSuc) {
+                while ((N = SubproblemPred(N)) != FirstNode);
+                if (SubproblemSuc(N) == N->BestSuc) {
                     N = FirstNode;
                     do {
-                        N->BestSuc->SubproblemPred = N;
-                        N = N->SubproblemSuc = N->BestSuc;
+                        SubproblemPred(N->BestSuc) = N;
+                        N = SubproblemSuc(N) = N->BestSuc;
                     }
                     while (N != FirstNode);
                 } else {
                     N = FirstNode;
-                    do
-                        (N->SubproblemPred = N->BestSuc)->SubproblemSuc =
-                            N;
+                    do {
+                        SubproblemPred(N) = N->BestSuc;
+                        SubproblemSuc(N->BestSuc) = N;
+                    }
                     while ((N = N->BestSuc) != FirstNode);
                 }
                 RecordBestTour();
@@ -292,12 +300,14 @@ SolveSubproblem(int CurrentSubproblem, int Subproblems,
                 Parent2 = LinearSelection(PopulationSize, 1.25);
             while (Parent1 == Parent2);
             ApplyCrossover(Parent1, Parent2);
+            if (!InitialSucTable)
+                InitialSucTable = (Node **) AllocateNodeTable(sizeof(Node *));
             N = FirstNode;
             do {
                 int d = C(N, N->Suc);
                 AddCandidate(N, N->Suc, d, INT_MAX);
                 AddCandidate(N->Suc, N, d, INT_MAX);
-                N = N->InitialSuc = N->Suc;
+                N = InitialSuc(N) = N->Suc;
             }
             while (N != FirstNode);
         }
@@ -309,24 +319,26 @@ SolveSubproblem(int CurrentSubproblem, int Subproblems,
     if (TraceLevel >= 1)
         PrintStatistics();
 
-    if (C == C_EXPLICIT) {
+    if (WeightType == EXPLICIT) {
         N = FirstNode;
         do {
-            for (i = 1; i < N->Id; i++) {
-                N->C[i] -= N->Pi + NodeSet[i].Pi;
-                N->C[i] /= Precision;
+            if (C == C_EXPLICIT) {
+                for (i = 1; i < N->Id; i++) {
+                    N->C[i] -= N->Pi + NodeSet[i].Pi;
+                    N->C[i] /= Precision;
+                }
             }
             if (N->FixedTo1 && N->FixedTo1 != N->FixedTo1Saved) {
                 if (N->Id > N->FixedTo1->Id)
-                    N->C[N->FixedTo1->Id] = N->SavedCost;
+                    StoreCost(N, N->FixedTo1->Id, N->SavedCost);
                 else
-                    N->FixedTo1->C[N->Id] = N->FixedTo1->SavedCost;
+                    StoreCost(N->FixedTo1, N->Id, N->FixedTo1->SavedCost);
             }
             if (N->FixedTo2 && N->FixedTo2 != N->FixedTo2Saved) {
                 if (N->Id > N->FixedTo2->Id)
-                    N->C[N->FixedTo2->Id] = N->SavedCost;
+                    StoreCost(N, N->FixedTo2->Id, N->SavedCost);
                 else
-                    N->FixedTo2->C[N->Id] = N->FixedTo2->SavedCost;
+                    StoreCost(N->FixedTo2, N->Id, N->FixedTo2->SavedCost);
             }
         }
         while ((N = N->Suc) != FirstNode);
@@ -335,19 +347,20 @@ SolveSubproblem(int CurrentSubproblem, int Subproblems,
     FreeSegments();
     FreeCandidateSets();
     FreePopulation();
+    ReleaseArena(&ScratchArena, ScratchMark);
     if (InitialTourEdges == Dimension) {
         do
-            N->InitialSuc = N->SubproblemSuc;
-        while ((N = N->SubproblemSuc) != FirstNode);
-    } else {
+            InitialSuc(N) = SubproblemSuc(N);
+        while ((N = SubproblemSuc(N)) != FirstNode);
+    } else if (InitialSucTable) {
         do
-            N->InitialSuc = 0;
-        while ((N = N->SubproblemSuc) != FirstNode);
+            InitialSuc(N) = 0;
+        while ((N = SubproblemSuc(N)) != FirstNode);
     }
     Dimension = ProblemType != ATSP ? DimensionSaved : 2 * DimensionSaved;
     N = FirstNode = FirstNodeSaved;
     do {
-        N->Suc = N->BestSuc = N->SubproblemSuc;
+        N->Suc = N->BestSuc = SubproblemSuc(N);
         N->Suc->Pred = N;
         Next = N->FixedTo1;
         N->FixedTo1 = N->FixedTo1Saved;
@@ -33,21 +33,22 @@ void SolveSubproblemBorderProblems(int Subproblems,
     int CurrentSubproblem;
     int *SubproblemSaved;
     double EntryTime = GetTime();
+    ArenaMark Mark = MarkArena(&ScratchArena);
 
-    assert(SubproblemSaved =
-           (int *) malloc((DimensionSaved + 1) * sizeof(int)));
+    SubproblemSaved = (int *)
+        ArenaAlloc(&ScratchArena, (DimensionSaved + 1) * sizeof(int));
     /* Compute upper bound for the original problem */
     N = FirstNode;
     do {
-        N->Suc = N->SubproblemSuc;
+        N->Suc = SubproblemSuc(N);
         N->Suc->Pred = N;
         if (N->Subproblem > Subproblems)
             N->Subproblem -= Subproblems;
         SubproblemSaved[N->Id] = N->Subproblem;
         N->FixedTo1Saved = N->FixedTo2Saved = 0;
-        N->SubBestPred = N->SubBestSuc = 0;
+        SubBestPred(N) = SubBestSuc(N) = 0;
     }
-    while ((N = N->SubproblemSuc) != FirstNode);
+    while ((N = SubproblemSuc(N)) != FirstNode);
     if (TraceLevel >= 1)
         printff("\n*** Solve subproblem border problems *** [" GainFormat
                 "]\n", *GlobalBestCost);
@@ -62,9 +63,9 @@ void SolveSubproblemBorderProblems(int Subproblems,
         N = FirstNode;
         do
             N->Subproblem = SubproblemSaved[N->Id];
-        while ((N = N->SubproblemSuc) != FirstNode);
+        while ((N = SubproblemSuc(N)) != FirstNode);
     }
-    free(SubproblemSaved);
+    ReleaseArena(&ScratchArena, Mark);
     printff("\nCost = " GainFormat, *GlobalBestCost);
     if (Optimum != MINUS_INFINITY && Optimum != 0)
         printff(", Gap = %0.4f%%",
@@ -87,22 +88,23 @@ static void MarkBorderPoints(int CurrentSubproblem)
     double Min[3], Max[3];
     int dMin, dMax, d, i, axis, ActualSubproblemSize = 0, Size = 0;
     Node **A, *N;
+    ArenaMark Mark = MarkArena(&ScratchArena);
 
-    assert(A = (Node **) malloc(DimensionSaved * sizeof(Node *)));
+    A = (Node **) ArenaAlloc(&ScratchArena, DimensionSaved * sizeof(Node *));
     Min[0] = Min[1] = Min[2] = DBL_MAX;
     Max[0] = Max[1] = Max[2] = -DBL_MAX;
     if (WeightType == GEO || WeightType == GEOM ||
         WeightType == GEO_MEEUS || WeightType == GEOM_MEEUS) {
         N = FirstNode;
         do {
-            N->Xc = N->X;
-            N->Yc = N->Y;
-            N->Zc = N->Z;
+            Xc(N) = N->X;
+            Yc(N) = N->Y;
+            Zc(N) = N->Z;
             if (WeightType == GEO || WeightType == GEO_MEEUS)
-                GEO2XYZ(N->Xc, N->Yc, &N->X, &N->Y, &N->Z);
+                GEO2XYZ(Xc(N), Yc(N), &N->X, &N->Y, &N->Z);
             else
-                GEOM2XYZ(N->Xc, N->Yc, &N->X, &N->Y, &N->Z);
-        } while ((N = N->SubproblemSuc) != FirstNode);
+                GEOM2XYZ(Xc(N), Yc(N), &N->X, &N->Y, &N->Z);
+        } while ((N = SubproblemSuc(N)) != FirstNode);
         CoordType = THREED_COORDS;
     }
     N = FirstNode;
@@ -116,7 +118,7 @@ static void MarkBorderPoints(int CurrentSubproblem)
             }
             ActualSubproblemSize++;
         }
-    } while ((N = N->SubproblemSuc) != FirstNode);
+    } while ((N = SubproblemSuc(N)) != FirstNode);
     do {
         if (N->Subproblem == CurrentSubproblem ||
             (N->X >= Min[0] && N->X <= Max[0] &&
@@ -163,27 +165,27 @@ static void MarkBorderPoints(int CurrentSubproblem)
         }
         N->Subproblem = 0;
         if (!SubproblemsCompressed ||
-            ((N->SubproblemPred != N->SubBestPred ||
-              N->SubproblemSuc != N->SubBestSuc) &&
-             (N->SubproblemPred != N->SubBestSuc ||
-              N->SubproblemSuc != N->SubBestPred)))
+            ((SubproblemPred(N) != SubBestPred(N) ||
+              SubproblemSuc(N) != SubBestSuc(N)) &&
+             (SubproblemPred(N) != SubBestSuc(N) ||
+              SubproblemSuc(N) != SubBestPred(N))))
             A[Size++] = N;
-    } while ((N = N->SubproblemSuc) != FirstNode);
+    } while ((N = SubproblemSuc(N)) != FirstNode);
     if (ActualSubproblemSize > Size)
         ActualSubproblemSize = Size;
     else
         QuickSelect(A, Size, ActualSubproblemSize);
     for (Size = 0; Size < ActualSubproblemSize; Size++)
         A[Size]->Subproblem = CurrentSubproblem;
-    free(A);
+    ReleaseArena(&ScratchArena, Mark);
     if (WeightType == GEO || WeightType == GEOM ||
         WeightType == GEO_MEEUS || WeightType == GEOM_MEEUS) {
         N = FirstNode;
         do {
-            N->X = N->Xc;
-            N->Y = N->Yc;
-            N->Z = N->Zc;
-        } while ((N = N->SubproblemSuc) != FirstNode);
+            N->X = Xc(N);
+            N->Y = Yc(N);
+            N->Z = Zc(N);
+        } while ((N = SubproblemSuc(N)) != FirstNode);
         CoordType = TWOD_COORDS;
     }
 }
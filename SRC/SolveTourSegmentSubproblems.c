@@ -32,11 +32,11 @@ void SolveTourSegmentSubproblems()
     GlobalBestCost = 0;
     N = FirstNodeSaved = FirstNode;
     do {
-        if (!Fixed(N, N->SubproblemSuc))
-            GlobalBestCost += Distance(N, N->SubproblemSuc);
+        if (!Fixed(N, SubproblemSuc(N)))
+            GlobalBestCost += Distance(N, SubproblemSuc(N));
         N->Subproblem = 0;
     }
-    while ((N = N->SubproblemSuc) != FirstNode);
+    while ((N = SubproblemSuc(N)) != FirstNode);
     for (Round = 1; Round <= 2; Round++) {
         if (Round == 2 && Subproblems == 1)
             break;
@@ -51,15 +51,15 @@ void SolveTourSegmentSubproblems()
         FirstNode = FirstNodeSaved;
         if (Round == 2)
             for (i = SubproblemSize / 2; i > 0; i--)
-                FirstNode = FirstNode->SubproblemSuc;
+                FirstNode = SubproblemSuc(FirstNode);
         for (CurrentSubproblem = 1;
              CurrentSubproblem <= Subproblems; CurrentSubproblem++) {
             for (i = 0, N = FirstNode; i < SubproblemSize;
-                 i++, N = N->SubproblemSuc) {
+                 i++, N = SubproblemSuc(N)) {
                 N->Subproblem =
                     (Round - 1) * Subproblems + CurrentSubproblem;
                 N->FixedTo1Saved = N->FixedTo2Saved = 0;
-                N->SubBestPred = N->SubBestSuc = 0;
+                SubBestPred(N) = SubBestSuc(N) = 0;
             }
             OldGlobalBestCost = GlobalBestCost;
             SolveSubproblem((Round - 1) * Subproblems + CurrentSubproblem,
@@ -15,6 +15,7 @@ void InitializeStatistics()
     TimeMax = 0;
     CostMin = PLUS_INFINITY;
     CostMax = MINUS_INFINITY;
+    CacheHits = CacheMisses = 0;
 }
 
 void UpdateStatistics(GainType Cost, double Time)
@@ -70,4 +71,42 @@ void PrintStatistics()
     printff
         ("Time.min = %0.2f sec., Time.avg = %0.2f sec., Time.max = %0.2f sec.\n",
          fabs(_TimeMin), fabs(TimeSum) / _Runs, fabs(TimeMax));
+    if (CacheHits + CacheMisses > 0)
+        printff("Cache: Sets = %d, Hits = %0.0f, Misses = %0.0f, "
+                "Hit rate = %0.2f%%\n", CacheMask + 1, CacheHits,
+                CacheMisses, 100.0 * CacheHits / (CacheHits + CacheMisses));
+}
+
+/*
+ * The WriteStatistics function writes the statistics to a file (see
+ * WriteCheckpoint). The ReadStatistics function restores statistics
+ * written by WriteStatistics, and returns 1 if they could be read;
+ * otherwise 0.
+ */
+
+#define Write(x) fwrite(&(x), sizeof(x), 1, f)
+#define Read(x) ReadInputBytes(f, &(x), sizeof(x))
+
+void WriteStatistics(FILE * f)
+{
+    Write(TrialsMin);
+    Write(TrialsMax);
+    Write(TrialSum);
+    Write(Successes);
+    Write(CostMin);
+    Write(CostMax);
+    Write(CostSum);
+    Write(TimeMin);
+    Write(TimeMax);
+    Write(TimeSum);
+    Write(CacheHits);
+    Write(CacheMisses);
+}
+
+int ReadStatistics(FILE * f)
+{
+    return Read(TrialsMin) && Read(TrialsMax) && Read(TrialSum) &&
+        Read(Successes) && Read(CostMin) && Read(CostMax) &&
+        Read(CostSum) && Read(TimeMin) && Read(TimeMax) &&
+        Read(TimeSum) && Read(CacheHits) && Read(CacheMisses);
 }
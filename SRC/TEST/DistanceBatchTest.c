@@ -0,0 +1,112 @@
+#include "LKH.h"
+
+/*
+ * The DistanceBatchTest program checks that DistanceBatch and
+ * DistanceBatchXYZ return exactly the same distances as the scalar
+ * distance functions for the edge weight types EUC_2D, EUC_3D, CEIL_2D,
+ * CEIL_3D, MAN_2D, MAN_3D, MAX_2D, MAX_3D and ATT. Each batch has a random
+ * size (so that both full SIMD blocks and the scalar remainder are used),
+ * and the coordinates are drawn from small integers (many distances are
+ * exact integers), large integers, half-integers and reals.
+ *
+ * The SIMD kernel is the one chosen for the processor running the test
+ * (AVX-512 or AVX2); on other processors only the scalar path is tested.
+ *
+ * The program exits with status 1 at the first difference; otherwise 0.
+ *
+ * Usage: DistanceBatchTest [ batches ]
+ */
+
+#define MAX_COUNT 40
+
+typedef struct Kernel {
+    char *Name;
+    int (*Distance) (Node * Na, Node * Nb);
+    int ThreeD;
+} Kernel;
+
+static Kernel Kernels[] = {
+    {"EUC_2D", Distance_EUC_2D, 0},
+    {"EUC_3D", Distance_EUC_3D, 1},
+    {"CEIL_2D", Distance_CEIL_2D, 0},
+    {"CEIL_3D", Distance_CEIL_3D, 1},
+    {"MAN_2D", Distance_MAN_2D, 0},
+    {"MAN_3D", Distance_MAN_3D, 1},
+    {"MAX_2D", Distance_MAX_2D, 0},
+    {"MAX_3D", Distance_MAX_3D, 1},
+    {"ATT", Distance_ATT, 0},
+};
+
+static double Coordinate(int Kind)
+{
+    double r = (double) Random() / INT_MAX;
+    switch (Kind) {
+    case 0:
+        return floor(r * 10);
+    case 1:
+        return floor(r * 1000000);
+    case 2:
+        return floor(r * 2000) / 2;
+    default:
+        return r * 1000000;
+    }
+}
+
+static void RandomNode(Node * N, int Kind)
+{
+    N->X = Coordinate(Kind);
+    N->Y = Coordinate(Kind);
+    N->Z = Coordinate(Kind);
+}
+
+static int Check(Kernel * T, Node * Na, Node * Nb, int D, char *Function)
+{
+    int d = T->Distance(Na, Nb);
+
+    if (D == d)
+        return 1;
+    printf("%s (%s): (%.17g %.17g %.17g, %.17g %.17g %.17g) = %d, "
+           "Distance = %d\n", Function, T->Name, Na->X, Na->Y, Na->Z,
+           Nb->X, Nb->Y, Nb->Z, D, d);
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    Node Na, NodeTable[MAX_COUNT], *Nb[MAX_COUNT];
+    double X[MAX_COUNT], Y[MAX_COUNT], Z[MAX_COUNT];
+    int D[MAX_COUNT], Count, Kind, i;
+    long Batches = argc > 1 ? atol(argv[1]) : 100000, b;
+    Kernel *T;
+
+    SRandom(1);
+    memset(&Na, 0, sizeof(Na));
+    memset(NodeTable, 0, sizeof(NodeTable));
+    for (i = 0; i < MAX_COUNT; i++)
+        Nb[i] = &NodeTable[i];
+    for (T = Kernels; T < Kernels + sizeof(Kernels) / sizeof(Kernels[0]);
+         T++) {
+        Distance = T->Distance;
+        for (b = 0; b < Batches; b++) {
+            Count = 1 + Random() % MAX_COUNT;
+            Kind = Random() % 4;
+            RandomNode(&Na, Kind);
+            for (i = 0; i < Count; i++) {
+                RandomNode(Nb[i], Kind);
+                X[i] = Nb[i]->X;
+                Y[i] = Nb[i]->Y;
+                Z[i] = Nb[i]->Z;
+            }
+            DistanceBatch(&Na, Nb, Count, D);
+            for (i = 0; i < Count; i++)
+                if (!Check(T, &Na, Nb[i], D[i], "DistanceBatch"))
+                    return 1;
+            DistanceBatchXYZ(&Na, X, Y, T->ThreeD ? Z : 0, Count, D);
+            for (i = 0; i < Count; i++)
+                if (!Check(T, &Na, Nb[i], D[i], "DistanceBatchXYZ"))
+                    return 1;
+        }
+        printf("DistanceBatch (%s): %ld batches OK\n", T->Name, Batches);
+    }
+    return 0;
+}
@@ -0,0 +1,109 @@
+#include "LKH.h"
+
+/*
+ * The Euc2DFloatTest program checks that Distance_EUC_2D_FLOAT returns
+ * exactly the same distances as Distance_EUC_2D. The pairs of points are
+ *
+ *   (1) random points with integer coordinates less than 2^20 in absolute
+ *       value,
+ *   (2) pairs whose distance is close to n + 0.5 for a random n, where
+ *       the single-precision square root is most likely to round wrongly,
+ *       with integer coordinates and with one non-integer coordinate,
+ *   (3) pairs of which one point has non-integer coordinates (as the
+ *       centers of SolveKMeansSubproblems), and
+ *   (4) pairs of corners of the square [-(2^20 - 1), 2^20 - 1]^2.
+ *
+ * The program exits with status 1 at the first difference; otherwise 0.
+ *
+ * Usage: Euc2DFloatTest [ pairs ]
+ */
+
+#define LIMIT ((1 << 20) - 1)
+
+static double IntegerCoordinate(int Range)
+{
+    return (double) (Random() % (2 * Range + 1)) - Range;
+}
+
+static int Check(Node * Na, Node * Nb)
+{
+    int d = Distance_EUC_2D(Na, Nb), f = Distance_EUC_2D_FLOAT(Na, Nb);
+
+    if (d == f)
+        return 1;
+    printf("Distance_EUC_2D_FLOAT(%.17g %.17g, %.17g %.17g) = %d, "
+           "Distance_EUC_2D = %d\n", Na->X, Na->Y, Nb->X, Nb->Y, f, d);
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    Node Na, Nb;
+    long Pairs = argc > 1 ? atol(argv[1]) : 1000000, i, Boundary = 0;
+    double R, xd, yd;
+    int k, Range;
+
+    SRandom(1);
+    memset(&Na, 0, sizeof(Na));
+    memset(&Nb, 0, sizeof(Nb));
+    for (i = 0; i < Pairs; i++) {
+        /* (1) */
+        Range = Random() % 2 ? LIMIT : 1 << (Random() % 21);
+        if (Range > LIMIT)
+            Range = LIMIT;
+        Na.X = IntegerCoordinate(Range);
+        Na.Y = IntegerCoordinate(Range);
+        Nb.X = IntegerCoordinate(Range);
+        Nb.Y = IntegerCoordinate(Range);
+        if (!Check(&Na, &Nb))
+            return 1;
+
+        /* (2) */
+        R = (Random() % (int) (2 * M_SQRT2 * LIMIT)) + 0.5;
+        xd = Random() % (int) (R < 2 * LIMIT ? R + 1 : 2 * LIMIT + 1);
+        yd = floor(sqrt(R * R - xd * xd));
+        for (k = -2; k <= 2; k++) {
+            if (yd + k < 0 || yd + k > 2 * LIMIT)
+                continue;
+            Na.X = floor(xd / 2);
+            Nb.X = Na.X - xd;
+            Na.Y = floor((yd + k) / 2);
+            Nb.Y = Na.Y - (yd + k);
+            if (Random() % 2)
+                Na.X = -Na.X, Nb.X = -Nb.X;
+            if (!Check(&Na, &Nb) || !Check(&Nb, &Na))
+                return 1;
+            Boundary++;
+        }
+        /* Squared distances (n + 0.5)^2 - 0.1 and (n + 0.5)^2 + 0.1 */
+        for (k = -1; k <= 1 && yd < 2 * LIMIT; k += 2) {
+            Na.Y = floor(yd / 2);
+            Nb.Y = Na.Y - sqrt(R * R + k * 0.1 - xd * xd);
+            if (!Check(&Na, &Nb) || !Check(&Nb, &Na))
+                return 1;
+            Boundary++;
+        }
+
+        /* (3) */
+        Na.X = IntegerCoordinate(LIMIT);
+        Na.Y = IntegerCoordinate(LIMIT);
+        Nb.X = IntegerCoordinate(LIMIT) + (double) Random() / INT_MAX;
+        Nb.Y = Random() % 2 ? IntegerCoordinate(LIMIT) + 0.5 :
+            IntegerCoordinate(LIMIT) + (double) Random() / INT_MAX;
+        if (!Check(&Na, &Nb) || !Check(&Nb, &Na))
+            return 1;
+    }
+
+    /* (4) */
+    for (i = 0; i < 16; i++) {
+        Na.X = i & 1 ? LIMIT : -LIMIT;
+        Na.Y = i & 2 ? LIMIT : -LIMIT;
+        Nb.X = i & 4 ? LIMIT : -LIMIT;
+        Nb.Y = i & 8 ? LIMIT : -LIMIT;
+        if (!Check(&Na, &Nb))
+            return 1;
+    }
+    printf("Distance_EUC_2D_FLOAT: %ld random, %ld near n + 0.5, "
+           "%ld non-integer pairs OK\n", Pairs, Boundary, Pairs);
+    return 0;
+}
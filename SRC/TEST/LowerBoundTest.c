@@ -0,0 +1,89 @@
+#include "LKH.h"
+
+/*
+ * The LowerBoundTest program checks that each of the lower-bound functions
+ * c_MAN_2D, c_MAN_3D, c_MAX_2D, c_MAX_3D, c_XRAY1 and c_XRAY2 never
+ * exceeds its distance function on random pairs of points. The coordinates
+ * are drawn from integers, half-integers (for which both the bounds and
+ * the distances are rounded at a tie) and reals.
+ *
+ * The program exits with status 1 at the first violation; otherwise 0.
+ *
+ * Usage: LowerBoundTest [ pairs ]
+ */
+
+typedef struct Bound {
+    char *Name;
+    int (*c) (Node * Na, Node * Nb);
+    int (*Distance) (Node * Na, Node * Nb);
+    int XRay;                   /* X is an angle in [0,360) */
+} Bound;
+
+static Bound Bounds[] = {
+    {"MAN_2D", c_MAN_2D, Distance_MAN_2D, 0},
+    {"MAN_3D", c_MAN_3D, Distance_MAN_3D, 0},
+    {"MAX_2D", c_MAX_2D, Distance_MAX_2D, 0},
+    {"MAX_3D", c_MAX_3D, Distance_MAX_3D, 0},
+    {"XRAY1", c_XRAY1, Distance_XRAY1, 1},
+    {"XRAY2", c_XRAY2, Distance_XRAY2, 1},
+};
+
+static double Coordinate(int Kind, double Range)
+{
+    double r = (double) Random() / INT_MAX;
+    switch (Kind) {
+    case 0:
+        return floor(r * Range);
+    case 1:
+        return floor(2 * r * Range) / 2;
+    default:
+        return r * Range;
+    }
+}
+
+static void RandomNode(Node * N, int XRay)
+{
+    int Kind = Random() % 3;
+    double Range = Random() % 2 ? 100 : 1000000;
+
+    N->X = XRay ? Coordinate(Kind, 360) : Coordinate(Kind, Range);
+    N->Y = Coordinate(Kind, Range);
+    N->Z = Coordinate(Kind, Range);
+    if (!XRay && Random() % 2)
+        N->X = -N->X;
+}
+
+int main(int argc, char *argv[])
+{
+    Node Na, Nb;
+    Bound *B;
+    long Pairs = argc > 1 ? atol(argv[1]) : 1000000, i;
+    int c, d;
+
+    SRandom(1);
+    Precision = 1;
+    memset(&Na, 0, sizeof(Na));
+    memset(&Nb, 0, sizeof(Nb));
+    for (B = Bounds; B < Bounds + sizeof(Bounds) / sizeof(Bounds[0]); B++) {
+        for (i = 0; i < Pairs; i++) {
+            RandomNode(&Na, B->XRay);
+            if (Random() % 4 == 0) {
+                /* Differences of exactly k + 0.5 */
+                Nb = Na;
+                Nb.X += (Random() % 1000) + 0.5;
+                Nb.Y += (Random() % 1000) + 0.5;
+                Nb.Z += (Random() % 1000) + 0.5;
+                if (B->XRay && Nb.X >= 360)
+                    Nb.X -= 360;
+            } else
+                RandomNode(&Nb, B->XRay);
+            if ((c = B->c(&Na, &Nb)) > (d = B->Distance(&Na, &Nb))) {
+                printf("c_%s(%f %f %f, %f %f %f) = %d > %d\n",
+                       B->Name, Na.X, Na.Y, Na.Z, Nb.X, Nb.Y, Nb.Z, c, d);
+                return 1;
+            }
+        }
+        printf("c_%s: %ld pairs OK\n", B->Name, Pairs);
+    }
+    return 0;
+}
@@ -0,0 +1,155 @@
+#include "Segment.h"
+#include "LKH.h"
+
+/*
+ * The functions in this file are used for tuning the segment sizes of the
+ * two-level and three-level tree representations to the 2-opt moves that
+ * are actually made.
+ *
+ * AllocateSegments chooses the sizes from the dimension of the problem
+ * (about sqrt(n) nodes per segment in the two-level tree). These sizes are
+ * good when the lengths of the reversed paths are uniformly distributed,
+ * but may be far from optimal for other distributions (e.g., for clustered
+ * instances).
+ *
+ * If SEGMENT_TUNING_TRIALS is positive, the Flip_SL and Flip_SSL functions
+ * call SampleFlip with the length of each path to be reversed during the
+ * first SEGMENT_TUNING_TRIALS trials. The lengths are kept in a reservoir
+ * sample of at most MAX_FLIP_SAMPLES lengths. After the last of these trials
+ * (called from FindTour), TuneSegments estimates the cost of making the
+ * sampled moves for a range of segment sizes and re-partitions the segments
+ * to the sizes with the smallest estimated cost.
+ *
+ * The estimated cost of reversing a path of L nodes (L <= n/2) with
+ * segments of size g (and super segments of s segments) is
+ *
+ *     L                  if L <= SPLIT_CUTOFF * g
+ *                           (the path is reversed within a segment),
+ *     g/2 + L/g          if L <= SPLIT_CUTOFF * g * s
+ *                           (a segment is split, and a sequence of
+ *                            segments is reversed),
+ *     g/2 + s/2 + L/(g*s) otherwise
+ *                           (a segment and a super segment are split, and
+ *                            a sequence of super segments is reversed).
+ *
+ * For the two-level tree s is infinite.
+ */
+
+#define MAX_FLIP_SAMPLES 10000
+
+static int FlipSample[MAX_FLIP_SAMPLES];
+static int Samples;
+static double Flips;
+static unsigned SampleSeed;
+
+static double FlipCost(double g, double s);
+
+/*
+ * The StartFlipSampling function starts sampling of flip lengths for the
+ * current problem. It is called from the AllocateSegments function.
+ */
+
+void StartFlipSampling()
+{
+    FlipSampling = SegmentTuningTrials > 0 &&
+        (CurrentTreeType == TWO_LEVEL_LIST ||
+         CurrentTreeType == THREE_LEVEL_LIST);
+    Samples = 0;
+    Flips = 0;
+    SampleSeed = 12345;
+}
+
+/*
+ * The SampleFlip function adds the length of a path to be reversed to the
+ * reservoir sample.
+ */
+
+void SampleFlip(int Length)
+{
+    int i;
+
+    /* SegmentSize_SL and SegmentSize_SSL only approximate the length */
+    if (Length > Dimension)
+        Length = Dimension;
+    if (2 * Length > Dimension)
+        Length = Dimension - Length;
+    Flips++;
+    if (Samples < MAX_FLIP_SAMPLES)
+        FlipSample[Samples++] = Length;
+    else {
+        /* A local generator is used so that sampling does not change the
+           sequence of random numbers used by the search */
+        SampleSeed = SampleSeed * 1103515245 + 12345;
+        if ((i = (int) (Flips * (SampleSeed >> 1) / 2147483648.0)) <
+            MAX_FLIP_SAMPLES)
+            FlipSample[i] = Length;
+    }
+}
+
+/*
+ * The TuneSegments function chooses GroupSize (and SGroupSize) so that the
+ * estimated cost of the sampled 2-opt moves is minimized, and re-partitions
+ * the segments accordingly. Sampling is stopped.
+ */
+
+void TuneSegments()
+{
+    double g, s, Cost, BestCost, OldCost, Step = pow(2.0, 0.25);
+    int BestGroupSize = GroupSize, BestSGroupSize = SGroupSize;
+
+    FlipSampling = 0;
+    if (Samples == 0)
+        return;
+    OldCost = BestCost =
+        FlipCost(GroupSize, CurrentTreeType == THREE_LEVEL_LIST ?
+                 SGroupSize : Dimension);
+    for (g = 4; 2 * g <= Dimension; g *= Step) {
+        if (CurrentTreeType == TWO_LEVEL_LIST) {
+            if ((Cost = FlipCost((int) g, Dimension)) < BestCost) {
+                BestCost = Cost;
+                BestGroupSize = (int) g;
+            }
+            continue;
+        }
+        for (s = 2; 2 * (int) g * (int) s <= Dimension; s *= Step) {
+            if ((Cost = FlipCost((int) g, (int) s)) < BestCost) {
+                BestCost = Cost;
+                BestGroupSize = (int) g;
+                BestSGroupSize = (int) s;
+            }
+        }
+    }
+    if (TraceLevel >= 1) {
+        printff("Segments tuned: GroupSize = %d (was %d)",
+                BestGroupSize, GroupSize);
+        if (CurrentTreeType == THREE_LEVEL_LIST)
+            printff(", SGroupSize = %d (was %d)",
+                    BestSGroupSize, SGroupSize);
+        printff(", Flips = %0.0f, Flip cost = %0.1f (was %0.1f)\n",
+                Flips, BestCost, OldCost);
+    }
+    if (BestGroupSize != GroupSize || BestSGroupSize != SGroupSize) {
+        GroupSize = BestGroupSize;
+        SGroupSize = BestSGroupSize;
+        PartitionSegments();
+    }
+}
+
+/*
+ * The FlipCost function returns the average estimated cost of the sampled
+ * 2-opt moves for segments of size g and super segments of s segments.
+ */
+
+static double FlipCost(double g, double s)
+{
+    double Sum = 0, L;
+    int i;
+
+    for (i = 0; i < Samples; i++) {
+        L = FlipSample[i];
+        Sum += L <= SPLIT_CUTOFF * g ? L :
+            L <= SPLIT_CUTOFF * g * s ? g / 2 + L / g :
+            g / 2 + s / 2 + L / (g * s);
+    }
+    return Sum / Samples;
+}
@@ -12,6 +12,11 @@
  * candidate edges. For each candidate edge its end node number and
  * alpha-value are given.
  *
+ * If the file name ends with ".bin", the file is written in binary: the
+ * header BINARY_CANDIDATE_HEADER followed by the same numbers as ints (in
+ * the native byte order), terminated by -1. Such a file is much faster to
+ * read by ReadCandidates.
+ *
  * The function is called from the CreateCandidateSet function.
  */
 
@@ -20,29 +25,42 @@
     由于默认情况下不指定输出文件，所以这个函数其实什么都没有做
  */
 
+static void WriteBinaryCandidates(FILE * CandidateFile);
+
 void WriteCandidates()
 {
     FILE *CandidateFile;
-    int i, Count;
+    int i, Count, Binary;
     Candidate *NN;
     Node *N;
 
-    if (CandidateFiles == 0 ||
-            !(CandidateFile = fopen(CandidateFileName[0], "w")))
+    if (CandidateFiles == 0)
+        return;
+    Binary = BinaryFileName(CandidateFileName[0]);
+    if (!(CandidateFile = fopen(CandidateFileName[0], Binary ? "wb" : "w")))
         return;
     if (TraceLevel >= 1)
         printff("Writing CANDIDATE_FILE: \"%s\" ... ",
                 CandidateFileName[0]);
+    if (Binary) {
+        WriteBinaryCandidates(CandidateFile);
+        fclose(CandidateFile);
+        if (TraceLevel >= 1)
+            printff("done\n");
+        return;
+    }
     fprintf(CandidateFile, "%d\n", Dimension);
     for (i = 1; i <= Dimension; i++) {
         N = &NodeSet[i];
-        fprintf(CandidateFile, "%d %d", N->Id, N->Dad ? N->Dad->Id : 0);
+        fprintf(CandidateFile, "%d %d", ExternalId(N->Id),
+                N->Dad ? ExternalId(N->Dad->Id) : 0);
         Count = 0;
         for (NN = N->CandidateSet; NN && NN->To; NN++)
             Count++;
         fprintf(CandidateFile, " %d ", Count);
         for (NN = N->CandidateSet; NN && NN->To; NN++)
-            fprintf(CandidateFile, "%d %d ", NN->To->Id, NN->Alpha);
+            fprintf(CandidateFile, "%d %d ", ExternalId(NN->To->Id),
+                    NN->Alpha);
         fprintf(CandidateFile, "\n");
     }
     fprintf(CandidateFile, "-1\nEOF\n");
@@ -50,3 +68,39 @@ void WriteCandidates()
     if (TraceLevel >= 1)
         printff("done\n");
 }
+
+/*
+ * The WriteBinaryCandidates function writes the numbers of each node as
+ * one block of ints.
+ */
+
+static void WriteBinaryCandidates(FILE * CandidateFile)
+{
+    int i, j, Count, MaxRow = 0, End = -1, *Row = 0;
+    Candidate *NN;
+    Node *N;
+
+    fputs(BINARY_CANDIDATE_HEADER, CandidateFile);
+    fwrite(&Dimension, sizeof(int), 1, CandidateFile);
+    for (i = 1; i <= Dimension; i++) {
+        N = &NodeSet[i];
+        Count = 0;
+        for (NN = N->CandidateSet; NN && NN->To; NN++)
+            Count++;
+        if (3 + 2 * Count > MaxRow) {
+            free(Row);
+            assert(Row = (int *) malloc((MaxRow = 3 + 2 * Count) *
+                                        sizeof(int)));
+        }
+        Row[0] = ExternalId(N->Id);
+        Row[1] = N->Dad ? ExternalId(N->Dad->Id) : 0;
+        Row[2] = Count;
+        for (j = 3, NN = N->CandidateSet; NN && NN->To; NN++) {
+            Row[j++] = ExternalId(NN->To->Id);
+            Row[j++] = NN->Alpha;
+        }
+        fwrite(Row, sizeof(int), j, CandidateFile);
+    }
+    fwrite(&End, sizeof(int), 1, CandidateFile);
+    free(Row);
+}
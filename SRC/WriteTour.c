@@ -6,7 +6,8 @@
  * 
  * The tour is written in "normal form": starting at node 1,
  * and continuing in direction of its lowest numbered
- * neighbor.
+ * neighbor. Node numbers are those of the problem file, also
+ * when the nodes have been renumbered (see RenumberNodes).
  * 
  * Nothing happens if FileName is 0. 
  */
@@ -38,11 +39,12 @@ void WriteTour(char *FileName, int *Tour, GainType Cost)
     fprintf(TourFile, "DIMENSION : %d\n", n);
     fprintf(TourFile, "TOUR_SECTION\n");
 
-    for (i = 1; i < n && Tour[i] != 1; i++);
+    for (i = 1; i < n && ExternalId(Tour[i]) != 1; i++);
     Forwards = ProblemType == ATSP ||
-        Tour[i < n ? i + 1 : 1] < Tour[i > 1 ? i - 1 : Dimension];
+        ExternalId(Tour[i < n ? i + 1 : 1]) <
+        ExternalId(Tour[i > 1 ? i - 1 : Dimension]);
     for (j = 1; j <= n; j++) {
-        fprintf(TourFile, "%d\n", Tour[i]);
+        fprintf(TourFile, "%d\n", ExternalId(Tour[i]));
         if (Forwards) {
             if (++i > n)
                 i = 1;